@@ -0,0 +1,453 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        alist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Doubly linked list in a contiguous arena with 32-bit links
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "alist.h"
+#include "string.h"
+#include "stdlib.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _HEAD_SIZE          (sizeof(alist_head_t))
+#define _ENTRY              (0u)            /* Slot of the list entry */
+#define _IDLE               (ALIST_NIL-1)   /* m_uiPrev of an idle node */
+#define _FREE               (ALIST_NIL-2)   /* m_uiPrev of a free slot */
+#define _MAX_SLOTS          (ALIST_NIL-2)
+#define _DEF_CAPACITY       (64u)
+
+#define _ALIGN_UP(n,a)      (((n)+(a)-1)&~((a)-1))
+#define _SLOT(l,i)          ((alist_head_t *)((l)->m_pBuf+(size_t)(i)*(l)->m_uiStride))
+#define _IS_SLOT(l,i)       (((i)!=_ENTRY)&&((i)<(l)->m_uiUsed))
+#define _IS_IDLE_NODE(l,i)  ((_IS_SLOT(l,i))&&(_SLOT(l,i)->m_uiPrev==_IDLE))
+#define _IS_USED_NODE(l,i)  ((_IS_SLOT(l,i))&&(_SLOT(l,i)->m_uiPrev<(l)->m_uiUsed))
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _ALIST_HEAD_T alist_head_t;
+typedef struct _ALIST_T alist_t;
+
+struct _ALIST_HEAD_T {
+    uint32_t m_uiNext;
+    uint32_t m_uiPrev;
+};
+
+struct _ALIST_T {
+    uint8_t *m_pBuf;            /* Slot 0 is the list entry */
+    uint32_t m_uiNodeSize;
+    uint32_t m_uiStride;
+    uint32_t m_uiCapacity;      /* Slots in the buffer */
+    uint32_t m_uiUsed;          /* Slots ever handed out */
+    uint32_t m_uiFree;          /* Free slots chained by m_uiNext */
+    uint32_t m_uiNodes;         /* Nodes allocated, in list or idle */
+    uint32_t m_uiSize;          /* Nodes in list */
+};
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _link
+ * @param [in]  psList - Pointer to a list
+ * @param [in]  uiPrev - Index of the node to link after
+ * @param [in]  uiNode - Index of an idle node
+ * @return      None
+ * @brief       Link an idle node after another node or the entry
+ *****************************************************************************/
+static void _link( alist_t *psList, uint32_t uiPrev, uint32_t uiNode )
+{
+    alist_head_t *psPrev = _SLOT(psList, uiPrev);
+    alist_head_t *psHead = _SLOT(psList, uiNode);
+    psHead->m_uiPrev = uiPrev;
+    psHead->m_uiNext = psPrev->m_uiNext;
+    _SLOT(psList, psPrev->m_uiNext)->m_uiPrev = uiNode;
+    psPrev->m_uiNext = uiNode;
+    psList->m_uiSize++;
+}
+
+/**************************************************************************//**
+ * @fn          _grow
+ * @param [in]  psList - Pointer to a list
+ * @return      true if there is room for one more slot
+ * @brief       Double the buffer of a list when all slots are handed out
+ *****************************************************************************/
+static bool _grow( alist_t *psList )
+{
+    uint32_t uiCapacity = psList->m_uiCapacity;
+    uint8_t *pBuf;
+    if( psList->m_uiUsed < uiCapacity ) {
+        return true;
+    }
+    if( uiCapacity >= _MAX_SLOTS ) {
+        return false;
+    }
+    uiCapacity = (uiCapacity > _MAX_SLOTS / 2)?_MAX_SLOTS:(uiCapacity * 2);
+    pBuf = realloc( psList->m_pBuf, (size_t)uiCapacity * psList->m_uiStride );
+    if( !pBuf ) {
+        return false;
+    }
+    psList->m_pBuf = pBuf;
+    psList->m_uiCapacity = uiCapacity;
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          _reset
+ * @param [in]  psList - Pointer to a list
+ * @return      None
+ * @brief       Give all slots back to the arena at once
+ *****************************************************************************/
+static void _reset( alist_t *psList )
+{
+    alist_head_t *psEntry = _SLOT(psList, _ENTRY);
+    psEntry->m_uiNext = _ENTRY;
+    psEntry->m_uiPrev = _ENTRY;
+    psList->m_uiUsed = 1;
+    psList->m_uiFree = ALIST_NIL;
+    psList->m_uiNodes = 0;
+    psList->m_uiSize = 0;
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          alist_create
+ * @param [in]  uiNodeSize - Size of user data field of every node
+ * @param [in]  uiCapacity - Number of nodes to reserve, 0 for default
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list. All nodes of the list live in one
+ *              growable buffer and are linked by 32-bit indices, so a node
+ *              costs 8 bytes on top of its user data field.
+ *****************************************************************************/
+void *alist_create( uint32_t uiNodeSize, uint32_t uiCapacity )
+{
+    alist_t *psList;
+    uint32_t uiAlign = (uiNodeSize < sizeof(uint64_t))?sizeof(uint32_t):sizeof(uint64_t);
+    if( uiNodeSize > UINT32_MAX / 2 ) {
+        return NULL;
+    }
+    uiCapacity = (uiCapacity && uiCapacity < _MAX_SLOTS)?(uiCapacity + 1):_DEF_CAPACITY;
+    psList = malloc( sizeof( alist_t ) );
+    if( psList ) {
+        psList->m_uiNodeSize = uiNodeSize;
+        psList->m_uiStride = _ALIGN_UP(_HEAD_SIZE + uiNodeSize, uiAlign);
+        psList->m_uiCapacity = uiCapacity;
+        psList->m_pBuf = malloc( (size_t)uiCapacity * psList->m_uiStride );
+        if( !psList->m_pBuf ) {
+            free( psList );
+            return NULL;
+        }
+        _reset( psList );
+    }
+    return psList;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_alloc
+ * @param [in]  pvList - List handle
+ * @return      Index of the created node or ALIST_NIL if failed
+ * @brief       Create a new element node in the arena of a list. The buffer
+ *              may move, so pointers got by alist_node_data become invalid.
+ *****************************************************************************/
+uint32_t alist_node_alloc( void *pvList )
+{
+    alist_t *psList = pvList;
+    uint32_t uiNode;
+    if( !psList ) {
+        return ALIST_NIL;
+    }
+    if( psList->m_uiFree != ALIST_NIL ) {
+        uiNode = psList->m_uiFree;
+        psList->m_uiFree = _SLOT(psList, uiNode)->m_uiNext;
+    } else if( _grow( psList ) ) {
+        uiNode = psList->m_uiUsed++;
+    } else {
+        return ALIST_NIL;
+    }
+    _SLOT(psList, uiNode)->m_uiPrev = _IDLE;
+    psList->m_uiNodes++;
+    return uiNode;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_free
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Give an idle node back to the arena of a list
+ *****************************************************************************/
+void alist_node_free( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    alist_head_t *psHead;
+    if( psList && _IS_IDLE_NODE(psList, uiNode) ) {
+        psHead = _SLOT(psList, uiNode);
+        psHead->m_uiPrev = _FREE;
+        psHead->m_uiNext = psList->m_uiFree;
+        psList->m_uiFree = uiNode;
+        psList->m_uiNodes--;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_data
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      Pointer to the user data field or NULL if not a node
+ * @brief       Get the user data field of a node. The pointer stays valid
+ *              until the next alist_node_alloc on the same list.
+ *****************************************************************************/
+void *alist_node_data( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_SLOT(psList, uiNode) && _SLOT(psList, uiNode)->m_uiPrev != _FREE ) {
+        return (void *)_SLOT(psList, uiNode) + _HEAD_SIZE;
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_size
+ * @param [in]  pvList - List handle
+ * @return      The size of user data field
+ * @brief       Get the size of user data field shared by all nodes
+ *****************************************************************************/
+uint32_t alist_node_size( void *pvList )
+{
+    alist_t *psList = pvList;
+    return psList?psList->m_uiNodeSize:0;
+}
+
+/**************************************************************************//**
+ * @fn          alist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Add a node at the end of a list
+ *****************************************************************************/
+void alist_add_rear( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_IDLE_NODE(psList, uiNode) ) {
+        _link( psList, _SLOT(psList, _ENTRY)->m_uiPrev, uiNode );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Add a node at the beginning of a list
+ *****************************************************************************/
+void alist_add_front( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_IDLE_NODE(psList, uiNode) ) {
+        _link( psList, _ENTRY, uiNode );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_insert_before
+ * @param [in]  pvList  - List handle
+ * @param [in]  uiNodeA - Index of a node.
+ * @param [in]  uiNodeB - Index of the node to be inserted.
+ * @return      None
+ * @brief       Insert a node before another node.
+ *****************************************************************************/
+void alist_insert_before( void *pvList, uint32_t uiNodeA, uint32_t uiNodeB )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_USED_NODE(psList, uiNodeA) && _IS_IDLE_NODE(psList, uiNodeB) ) {
+        _link( psList, _SLOT(psList, uiNodeA)->m_uiPrev, uiNodeB );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_insert_after
+ * @param [in]  pvList  - List handle
+ * @param [in]  uiNodeA - Index of a node.
+ * @param [in]  uiNodeB - Index of the node to be inserted.
+ * @return      None
+ * @brief       Insert a node after another node.
+ *****************************************************************************/
+void alist_insert_after( void *pvList, uint32_t uiNodeA, uint32_t uiNodeB )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_USED_NODE(psList, uiNodeA) && _IS_IDLE_NODE(psList, uiNodeB) ) {
+        _link( psList, uiNodeA, uiNodeB );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_del
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      None
+ * @brief       Delete a node from list. Note the node will not be freed.
+ *****************************************************************************/
+void alist_node_del( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    alist_head_t *psHead;
+    if( psList && _IS_USED_NODE(psList, uiNode) ) {
+        psHead = _SLOT(psList, uiNode);
+        _SLOT(psList, psHead->m_uiPrev)->m_uiNext = psHead->m_uiNext;
+        _SLOT(psList, psHead->m_uiNext)->m_uiPrev = psHead->m_uiPrev;
+        psHead->m_uiPrev = _IDLE;
+        psList->m_uiSize--;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_first
+ * @param [in]  pvList - List handle
+ * @return      Index of the node or ALIST_NIL if not founded
+ * @brief       Get the node at the beginning of the specified list.
+ *****************************************************************************/
+uint32_t alist_node_first( void *pvList )
+{
+    alist_t *psList = pvList;
+    uint32_t uiNode = psList?_SLOT(psList, _ENTRY)->m_uiNext:_ENTRY;
+    return (uiNode != _ENTRY)?uiNode:ALIST_NIL;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_last
+ * @param [in]  pvList - List handle
+ * @return      Index of the node or ALIST_NIL if not founded
+ * @brief       Get the node at the end of the specified list.
+ *****************************************************************************/
+uint32_t alist_node_last( void *pvList )
+{
+    alist_t *psList = pvList;
+    uint32_t uiNode = psList?_SLOT(psList, _ENTRY)->m_uiPrev:_ENTRY;
+    return (uiNode != _ENTRY)?uiNode:ALIST_NIL;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_next
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      Index of the next node
+ * @brief       Get next node or ALIST_NIL if reach the end of list
+ *****************************************************************************/
+uint32_t alist_node_next( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_USED_NODE(psList, uiNode) ) {
+        uiNode = _SLOT(psList, uiNode)->m_uiNext;
+        return (uiNode != _ENTRY)?uiNode:ALIST_NIL;
+    }
+    return ALIST_NIL;
+}
+
+/**************************************************************************//**
+ * @fn          alist_node_prev
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      Index of the previous node
+ * @brief       Get previous node or ALIST_NIL if reach the beginning of list
+ *****************************************************************************/
+uint32_t alist_node_prev( void *pvList, uint32_t uiNode )
+{
+    alist_t *psList = pvList;
+    if( psList && _IS_USED_NODE(psList, uiNode) ) {
+        uiNode = _SLOT(psList, uiNode)->m_uiPrev;
+        return (uiNode != _ENTRY)?uiNode:ALIST_NIL;
+    }
+    return ALIST_NIL;
+}
+
+/**************************************************************************//**
+ * @fn          alist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Get the number of nodes in a list.
+ *****************************************************************************/
+uint32_t alist_length( void *pvList )
+{
+    alist_t *psList = pvList;
+    return psList?psList->m_uiSize:0;
+}
+
+/**************************************************************************//**
+ * @fn          alist_flush
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Flush a list. All nodes in list will be deleted and freed
+ *****************************************************************************/
+void alist_flush( void *pvList )
+{
+    alist_t *psList = pvList;
+    alist_head_t *psEntry;
+    uint32_t uiNode;
+    if( !psList ) {
+        return;
+    }
+    if( psList->m_uiNodes == psList->m_uiSize ) {
+        /* No idle node is held outside the list, drop the whole arena */
+        _reset( psList );
+        return;
+    }
+    psEntry = _SLOT(psList, _ENTRY);
+    while( psEntry->m_uiNext != _ENTRY ) {
+        uiNode = psEntry->m_uiNext;
+        alist_node_del( psList, uiNode );
+        alist_node_free( psList, uiNode );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          alist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including the whole arena.
+ *****************************************************************************/
+void alist_destroy( void *pvList )
+{
+    alist_t *psList = pvList;
+    if( psList ) {
+        free( psList->m_pBuf );
+        free( psList );
+    }
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
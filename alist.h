@@ -0,0 +1,217 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        alist.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Doubly linked list in a contiguous arena with 32-bit links
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _ALIST_H_
+#define _ALIST_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Macro Definitions ------------------------------------------------------- */
+
+/* Node index standing for no node */
+#define ALIST_NIL   (UINT32_MAX)
+
+/* External Interfaces ----------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          alist_create
+ * @param [in]  uiNodeSize - Size of user data field of every node
+ * @param [in]  uiCapacity - Number of nodes to reserve, 0 for default
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list. All nodes of the list live in one
+ *              growable buffer and are linked by 32-bit indices, so a node
+ *              costs 8 bytes on top of its user data field.
+ *****************************************************************************/
+void *alist_create( uint32_t uiNodeSize, uint32_t uiCapacity );
+
+/**************************************************************************//**
+ * @fn          alist_node_alloc
+ * @param [in]  pvList - List handle
+ * @return      Index of the created node or ALIST_NIL if failed
+ * @brief       Create a new element node in the arena of a list. The buffer
+ *              may move, so pointers got by alist_node_data become invalid.
+ *****************************************************************************/
+uint32_t alist_node_alloc( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_node_free
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Give an idle node back to the arena of a list
+ *****************************************************************************/
+void alist_node_free( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_node_data
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      Pointer to the user data field or NULL if not a node
+ * @brief       Get the user data field of a node. The pointer stays valid
+ *              until the next alist_node_alloc on the same list.
+ *****************************************************************************/
+void *alist_node_data( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_node_size
+ * @param [in]  pvList - List handle
+ * @return      The size of user data field
+ * @brief       Get the size of user data field shared by all nodes
+ *****************************************************************************/
+uint32_t alist_node_size( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Add a node at the end of a list
+ *****************************************************************************/
+void alist_add_rear( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node
+ * @return      None
+ * @brief       Add a node at the beginning of a list
+ *****************************************************************************/
+void alist_add_front( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_insert_before
+ * @param [in]  pvList  - List handle
+ * @param [in]  uiNodeA - Index of a node.
+ * @param [in]  uiNodeB - Index of the node to be inserted.
+ * @return      None
+ * @brief       Insert a node before another node.
+ *****************************************************************************/
+void alist_insert_before( void *pvList, uint32_t uiNodeA, uint32_t uiNodeB );
+
+/**************************************************************************//**
+ * @fn          alist_insert_after
+ * @param [in]  pvList  - List handle
+ * @param [in]  uiNodeA - Index of a node.
+ * @param [in]  uiNodeB - Index of the node to be inserted.
+ * @return      None
+ * @brief       Insert a node after another node.
+ *****************************************************************************/
+void alist_insert_after( void *pvList, uint32_t uiNodeA, uint32_t uiNodeB );
+
+/**************************************************************************//**
+ * @fn          alist_node_del
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      None
+ * @brief       Delete a node from list. Note the node will not be freed.
+ *****************************************************************************/
+void alist_node_del( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_node_first
+ * @param [in]  pvList - List handle
+ * @return      Index of the node or ALIST_NIL if not founded
+ * @brief       Get the node at the beginning of the specified list.
+ *****************************************************************************/
+uint32_t alist_node_first( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_node_last
+ * @param [in]  pvList - List handle
+ * @return      Index of the node or ALIST_NIL if not founded
+ * @brief       Get the node at the end of the specified list.
+ *****************************************************************************/
+uint32_t alist_node_last( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_node_next
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      Index of the next node
+ * @brief       Get next node or ALIST_NIL if reach the end of list
+ *****************************************************************************/
+uint32_t alist_node_next( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_node_prev
+ * @param [in]  pvList - List handle
+ * @param [in]  uiNode - Index of a node.
+ * @return      Index of the previous node
+ * @brief       Get previous node or ALIST_NIL if reach the beginning of list
+ *****************************************************************************/
+uint32_t alist_node_prev( void *pvList, uint32_t uiNode );
+
+/**************************************************************************//**
+ * @fn          alist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Get the number of nodes in a list.
+ *****************************************************************************/
+uint32_t alist_length( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_flush
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Flush a list. All nodes in list will be deleted and freed
+ *****************************************************************************/
+void alist_flush( void *pvList );
+
+/**************************************************************************//**
+ * @fn          alist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including the whole arena.
+ *****************************************************************************/
+void alist_destroy( void *pvList );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ALIST_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,723 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        list_bench.cpp
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Benchmark of the list operations against array-backed and
+ *              std::list baselines
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *
+ * Every operation is timed over a set of lists holding at least _SET_NODES
+ * nodes in total, so short lists are measured many at a time instead of
+ * through a timer call per list. Each point is run a number of trials and
+ * the median is reported. Node deletion follows a fixed pseudo random order
+ * so that runs can be compared. Cache misses are counted with
+ * perf_event_open where the kernel allows it. Results are printed and
+ * written as CSV with one row per implementation, operation, list length
+ * and payload size.
+ *
+ * The baselines are alist, the array-backed list of this repository, and
+ * std::list. std::list cannot link or unlink without allocating or freeing,
+ * so its add, insert and del rows include the allocator while its alloc
+ * and free rows are left out.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <ctime>
+#include <algorithm>
+#include <list>
+#include <vector>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "list.h"
+#include "alist.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _SET_NODES          (16384)     /* Nodes per timed set at least */
+#define _DEF_TRIALS         (5)
+#define _DEF_MAX_NODES      (10000000)
+#define _DEF_MEM_MB         (1024)      /* Skip points needing more memory */
+#define _NODE_OVERHEAD      (64)        /* Head plus malloc, for the budget */
+#define _SEED               (0x2545F491u)
+
+/* Type Definitions -------------------------------------------------------- */
+
+enum {
+    OP_ALLOC = 0,
+    OP_ADD_REAR,
+    OP_TRAVERSE,
+    OP_DEL,
+    OP_ADD_FRONT,
+    OP_INSERT,
+    OP_FLUSH,
+    OP_DESTROY,
+    OP_FREE,
+    OP_COUNT
+};
+
+typedef struct _SAMPLE_T sample_t;
+typedef struct _PROBE_T probe_t;
+typedef struct _POINT_T point_t;
+
+/* One timed run of an operation, no ops if the implementation has none */
+struct _SAMPLE_T {
+    uint64_t m_ulNs;
+    uint64_t m_ulMiss;
+    uint64_t m_ulOps;
+};
+
+struct _PROBE_T {
+    int m_iFd;                  /* Cache miss counter or -1 */
+    struct timespec m_stStart;
+};
+
+/* Shape of a measured set: uiLists lists of uiNodes nodes each */
+struct _POINT_T {
+    uint32_t m_uiLists;
+    uint32_t m_uiNodes;
+    uint32_t m_uiSize;
+    const uint32_t *m_puiOrder; /* Deletion order within a list */
+};
+
+typedef void (*round_t)( const point_t *psPoint, probe_t *psProbe, sample_t *psOut );
+
+/* Local Variables --------------------------------------------------------- */
+
+static const char *s_apcOp[OP_COUNT] = {
+    "alloc", "add_rear", "traverse", "node_del", "add_front",
+    "insert_before", "flush", "destroy", "free"
+};
+
+static const uint32_t s_auiSize[] = { 8, 64, 512, 4096 };
+
+static volatile uint64_t s_ulSink;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _probe_open
+ * @param [out] psProbe - Pointer to a probe
+ * @return      None
+ * @brief       Open the cache miss counter of the calling thread, leaving it
+ *              off if perf_event_open is not available
+ *****************************************************************************/
+static void _probe_open( probe_t *psProbe )
+{
+    struct perf_event_attr stAttr;
+    memset( &stAttr, 0, sizeof( stAttr ) );
+    stAttr.type = PERF_TYPE_HARDWARE;
+    stAttr.size = sizeof( stAttr );
+    stAttr.config = PERF_COUNT_HW_CACHE_MISSES;
+    stAttr.disabled = 1;
+    stAttr.exclude_kernel = 1;
+    stAttr.exclude_hv = 1;
+    psProbe->m_iFd = (int)syscall( SYS_perf_event_open, &stAttr, 0, -1, -1, 0 );
+}
+
+/**************************************************************************//**
+ * @fn          _probe_begin
+ * @param [in]  psProbe - Pointer to a probe
+ * @return      None
+ * @brief       Start timing and counting
+ *****************************************************************************/
+static void _probe_begin( probe_t *psProbe )
+{
+    if( psProbe->m_iFd >= 0 ) {
+        ioctl( psProbe->m_iFd, PERF_EVENT_IOC_RESET, 0 );
+        ioctl( psProbe->m_iFd, PERF_EVENT_IOC_ENABLE, 0 );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &psProbe->m_stStart );
+}
+
+/**************************************************************************//**
+ * @fn          _probe_end
+ * @param [in]  psProbe - Pointer to a probe
+ * @param [out] psOut   - Sample to fill
+ * @param [in]  ulOps   - Number of operations done since _probe_begin
+ * @return      None
+ * @brief       Stop timing and counting
+ *****************************************************************************/
+static void _probe_end( probe_t *psProbe, sample_t *psOut, uint64_t ulOps )
+{
+    struct timespec stEnd;
+    uint64_t ulMiss = 0;
+    clock_gettime( CLOCK_MONOTONIC, &stEnd );
+    if( psProbe->m_iFd >= 0 ) {
+        ioctl( psProbe->m_iFd, PERF_EVENT_IOC_DISABLE, 0 );
+        if( read( psProbe->m_iFd, &ulMiss, sizeof( ulMiss ) ) != sizeof( ulMiss ) ) {
+            ulMiss = 0;
+        }
+    }
+    psOut->m_ulNs = (uint64_t)(stEnd.tv_sec - psProbe->m_stStart.tv_sec) * 1000000000ull
+                    + stEnd.tv_nsec - psProbe->m_stStart.tv_nsec;
+    psOut->m_ulMiss = ulMiss;
+    psOut->m_ulOps = ulOps;
+}
+
+/**************************************************************************//**
+ * @fn          _order_make
+ * @param [in]  uiNodes - Number of nodes in a list
+ * @return      Permutation of 0 .. uiNodes - 1
+ * @brief       Make the fixed pseudo random deletion order of a list length
+ *****************************************************************************/
+static std::vector<uint32_t> _order_make( uint32_t uiNodes )
+{
+    std::vector<uint32_t> auiOrder( uiNodes );
+    uint32_t uiSeed = _SEED;
+    uint32_t i;
+    for( i = 0; i < uiNodes; i++ ) {
+        auiOrder[i] = i;
+    }
+    for( i = uiNodes; i > 1; i-- ) {
+        uiSeed ^= uiSeed << 13;
+        uiSeed ^= uiSeed >> 17;
+        uiSeed ^= uiSeed << 5;
+        std::swap( auiOrder[i - 1], auiOrder[uiSeed % i] );
+    }
+    return auiOrder;
+}
+
+/**************************************************************************//**
+ * @fn          _round_list
+ * @param [in]  psPoint - Shape of the set
+ * @param [in]  psProbe - Pointer to a probe
+ * @param [out] psOut   - Samples of all operations
+ * @return      None
+ * @brief       Run every operation once on a set of lists of list.c
+ *****************************************************************************/
+static void _round_list( const point_t *psPoint, probe_t *psProbe, sample_t *psOut )
+{
+    const uint32_t uiLists = psPoint->m_uiLists;
+    const uint32_t uiNodes = psPoint->m_uiNodes;
+    const uint64_t ulAll = (uint64_t)uiLists * uiNodes;
+    std::vector<void *> apvList( uiLists );
+    std::vector<void *> apvNode( ulAll );
+    uint64_t ulSum = 0;
+    uint64_t ulHalf = 0;
+    uint64_t i;
+    uint32_t k;
+    uint32_t j;
+    void *pvNode;
+
+    for( k = 0; k < uiLists; k++ ) {
+        apvList[k] = list_create();
+    }
+    _probe_begin( psProbe );
+    for( i = 0; i < ulAll; i++ ) {
+        apvNode[i] = list_node_alloc( psPoint->m_uiSize );
+    }
+    _probe_end( psProbe, &psOut[OP_ALLOC], ulAll );
+    for( i = 0; i < ulAll; i++ ) {
+        memcpy( apvNode[i], &i, sizeof( i ) );
+    }
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            list_add_rear( apvList[k], apvNode[i] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_REAR], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( pvNode = list_node_first( apvList[k] ); pvNode; pvNode = list_node_next( pvNode ) ) {
+            ulSum += *(uint64_t *)pvNode;
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_TRAVERSE], ulAll );
+    s_ulSink += ulSum;
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++ ) {
+            list_node_del( apvNode[(uint64_t)k * uiNodes + psPoint->m_puiOrder[j]] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_DEL], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            list_add_front( apvList[k], apvNode[i] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_FRONT], ulAll );
+
+    /* Take every other node out and put it back before its neighbour */
+    for( i = 1; i < ulAll; i += 2 ) {
+        list_node_del( apvNode[i] );
+        ulHalf++;
+    }
+    _probe_begin( psProbe );
+    for( i = 1; i < ulAll; i += 2 ) {
+        list_insert_before( apvNode[i - 1], apvNode[i] );
+    }
+    _probe_end( psProbe, &psOut[OP_INSERT], ulHalf );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        list_flush( apvList[k] );
+    }
+    _probe_end( psProbe, &psOut[OP_FLUSH], ulAll );
+
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            list_add_rear( apvList[k], list_node_alloc( psPoint->m_uiSize ) );
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        list_destroy( apvList[k] );
+    }
+    _probe_end( psProbe, &psOut[OP_DESTROY], ulAll );
+
+    for( i = 0; i < ulAll; i++ ) {
+        apvNode[i] = list_node_alloc( psPoint->m_uiSize );
+    }
+    _probe_begin( psProbe );
+    for( i = 0; i < ulAll; i++ ) {
+        list_node_free( apvNode[i] );
+    }
+    _probe_end( psProbe, &psOut[OP_FREE], ulAll );
+}
+
+/**************************************************************************//**
+ * @fn          _round_alist
+ * @param [in]  psPoint - Shape of the set
+ * @param [in]  psProbe - Pointer to a probe
+ * @param [out] psOut   - Samples of all operations
+ * @return      None
+ * @brief       Run every operation once on a set of array-backed lists
+ *****************************************************************************/
+static void _round_alist( const point_t *psPoint, probe_t *psProbe, sample_t *psOut )
+{
+    const uint32_t uiLists = psPoint->m_uiLists;
+    const uint32_t uiNodes = psPoint->m_uiNodes;
+    const uint64_t ulAll = (uint64_t)uiLists * uiNodes;
+    std::vector<void *> apvList( uiLists );
+    std::vector<uint32_t> auiNode( ulAll );
+    uint64_t ulSum = 0;
+    uint64_t ulHalf = 0;
+    uint64_t i;
+    uint32_t k;
+    uint32_t j;
+    uint32_t uiNode;
+
+    for( k = 0; k < uiLists; k++ ) {
+        apvList[k] = alist_create( psPoint->m_uiSize, uiNodes );
+    }
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            auiNode[i] = alist_node_alloc( apvList[k] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ALLOC], ulAll );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            memcpy( alist_node_data( apvList[k], auiNode[i] ), &i, sizeof( i ) );
+        }
+    }
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            alist_add_rear( apvList[k], auiNode[i] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_REAR], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( uiNode = alist_node_first( apvList[k] ); uiNode != ALIST_NIL;
+             uiNode = alist_node_next( apvList[k], uiNode ) ) {
+            ulSum += *(uint64_t *)alist_node_data( apvList[k], uiNode );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_TRAVERSE], ulAll );
+    s_ulSink += ulSum;
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++ ) {
+            alist_node_del( apvList[k], auiNode[(uint64_t)k * uiNodes + psPoint->m_puiOrder[j]] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_DEL], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            alist_add_front( apvList[k], auiNode[i] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_FRONT], ulAll );
+
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            if( j & 1 ) {
+                alist_node_del( apvList[k], auiNode[i] );
+                ulHalf++;
+            }
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            if( j & 1 ) {
+                alist_insert_before( apvList[k], auiNode[i - 1], auiNode[i] );
+            }
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_INSERT], ulHalf );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        alist_flush( apvList[k] );
+    }
+    _probe_end( psProbe, &psOut[OP_FLUSH], ulAll );
+
+    for( k = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++ ) {
+            alist_add_rear( apvList[k], alist_node_alloc( apvList[k] ) );
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        alist_destroy( apvList[k] );
+    }
+    _probe_end( psProbe, &psOut[OP_DESTROY], ulAll );
+
+    for( k = 0; k < uiLists; k++ ) {
+        apvList[k] = alist_create( psPoint->m_uiSize, uiNodes );
+        for( j = 0; j < uiNodes; j++ ) {
+            auiNode[(uint64_t)k * uiNodes + j] = alist_node_alloc( apvList[k] );
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            alist_node_free( apvList[k], auiNode[i] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_FREE], ulAll );
+    for( k = 0; k < uiLists; k++ ) {
+        alist_destroy( apvList[k] );
+    }
+}
+
+/* Payload of std::list, only the first word is written */
+template <uint32_t SIZE>
+struct payload_t {
+    explicit payload_t( uint64_t ulValue ) { memcpy( m_aData, &ulValue, sizeof( ulValue ) ); }
+    uint8_t m_aData[SIZE];
+};
+
+/**************************************************************************//**
+ * @fn          _round_std
+ * @param [in]  psPoint - Shape of the set
+ * @param [in]  psProbe - Pointer to a probe
+ * @param [out] psOut   - Samples of all operations
+ * @return      None
+ * @brief       Run every operation once on a set of std::list
+ *****************************************************************************/
+template <uint32_t SIZE>
+static void _round_std( const point_t *psPoint, probe_t *psProbe, sample_t *psOut )
+{
+    typedef std::list<payload_t<SIZE> > list_t;
+    const uint32_t uiLists = psPoint->m_uiLists;
+    const uint32_t uiNodes = psPoint->m_uiNodes;
+    const uint64_t ulAll = (uint64_t)uiLists * uiNodes;
+    std::vector<list_t> asList( uiLists );
+    std::vector<typename list_t::iterator> aiNode( ulAll );
+    uint64_t ulSum = 0;
+    uint64_t ulHalf = 0;
+    uint64_t i;
+    uint32_t k;
+    uint32_t j;
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            asList[k].emplace_back( i );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_REAR], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( const payload_t<SIZE> &rNode : asList[k] ) {
+            ulSum += *(const uint64_t *)rNode.m_aData;
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_TRAVERSE], ulAll );
+    s_ulSink += ulSum;
+
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( typename list_t::iterator iNode = asList[k].begin(); iNode != asList[k].end(); ++iNode ) {
+            aiNode[i++] = iNode;
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++ ) {
+            asList[k].erase( aiNode[(uint64_t)k * uiNodes + psPoint->m_puiOrder[j]] );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_DEL], ulAll );
+
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            asList[k].emplace_front( i );
+        }
+    }
+    _probe_end( psProbe, &psOut[OP_ADD_FRONT], ulAll );
+
+    /* Every other node is erased and then emplaced before its neighbour */
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( typename list_t::iterator iNode = asList[k].begin(); iNode != asList[k].end(); ) {
+            aiNode[i++] = iNode++;
+            if( iNode != asList[k].end() ) {
+                iNode = asList[k].erase( iNode );
+                ulHalf++;
+            }
+        }
+    }
+    _probe_begin( psProbe );
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j + 1 < uiNodes; j += 2, i++ ) {
+            asList[k].emplace( aiNode[i], i );
+        }
+        i += uiNodes & 1;
+    }
+    _probe_end( psProbe, &psOut[OP_INSERT], ulHalf );
+
+    _probe_begin( psProbe );
+    for( k = 0; k < uiLists; k++ ) {
+        asList[k].clear();
+    }
+    _probe_end( psProbe, &psOut[OP_FLUSH], ulAll );
+
+    for( k = 0, i = 0; k < uiLists; k++ ) {
+        for( j = 0; j < uiNodes; j++, i++ ) {
+            asList[k].emplace_back( i );
+        }
+    }
+    _probe_begin( psProbe );
+    asList.clear();
+    _probe_end( psProbe, &psOut[OP_DESTROY], ulAll );
+}
+
+/**************************************************************************//**
+ * @fn          _round_std_any
+ * @param [in]  psPoint - Shape of the set
+ * @param [in]  psProbe - Pointer to a probe
+ * @param [out] psOut   - Samples of all operations
+ * @return      None
+ * @brief       Run _round_std instantiated for the payload size of a point
+ *****************************************************************************/
+static void _round_std_any( const point_t *psPoint, probe_t *psProbe, sample_t *psOut )
+{
+    switch( psPoint->m_uiSize ) {
+    case 8:
+        _round_std<8>( psPoint, psProbe, psOut );
+        break;
+    case 64:
+        _round_std<64>( psPoint, psProbe, psOut );
+        break;
+    case 512:
+        _round_std<512>( psPoint, psProbe, psOut );
+        break;
+    default:
+        _round_std<4096>( psPoint, psProbe, psOut );
+        break;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _sample_cmp
+ * @param [in]  rA - A sample
+ * @param [in]  rB - Another sample
+ * @return      true if rA took less time
+ * @brief       Order samples by time for the median
+ *****************************************************************************/
+static bool _sample_cmp( const sample_t &rA, const sample_t &rB )
+{
+    return rA.m_ulNs < rB.m_ulNs;
+}
+
+/**************************************************************************//**
+ * @fn          _usage
+ * @param [in]  pcName - Program name
+ * @return      None
+ * @brief       Print the command line options
+ *****************************************************************************/
+static void _usage( const char *pcName )
+{
+    printf( "Usage: %s [options]\n"
+            "  --out FILE        Write results as CSV to FILE\n"
+            "  --max-nodes N     Longest list length to sweep, default %u\n"
+            "  --trials N        Runs per point, the median is reported, default %u\n"
+            "  --mem-mb N        Skip points needing more memory, default %u\n",
+            pcName, _DEF_MAX_NODES, _DEF_TRIALS, _DEF_MEM_MB );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( int argc, char *argv[] )
+{
+    static const struct {
+        const char *m_pcName;
+        round_t m_pfnRound;
+    } astImpl[] = {
+        { "easylist", _round_list },
+        { "alist", _round_alist },
+        { "std_list", _round_std_any },
+    };
+    const char *pcOut = NULL;
+    uint64_t ulMaxNodes = _DEF_MAX_NODES;
+    uint64_t ulMemMb = _DEF_MEM_MB;
+    uint32_t uiTrials = _DEF_TRIALS;
+    FILE *psCsv = NULL;
+    probe_t stProbe;
+    point_t stPoint;
+    std::vector<uint32_t> auiOrder;
+    std::vector<sample_t> asTrial[OP_COUNT];
+    sample_t asOut[OP_COUNT];
+    uint64_t ulNodes;
+    size_t m;
+    uint32_t t;
+    int i;
+
+    for( i = 1; i < argc; i++ ) {
+        if( !strcmp( argv[i], "--out" ) && i + 1 < argc ) {
+            pcOut = argv[++i];
+        } else if( !strcmp( argv[i], "--max-nodes" ) && i + 1 < argc ) {
+            ulMaxNodes = strtoull( argv[++i], NULL, 0 );
+        } else if( !strcmp( argv[i], "--trials" ) && i + 1 < argc ) {
+            uiTrials = (uint32_t)strtoul( argv[++i], NULL, 0 );
+        } else if( !strcmp( argv[i], "--mem-mb" ) && i + 1 < argc ) {
+            ulMemMb = strtoull( argv[++i], NULL, 0 );
+        } else {
+            _usage( argv[0] );
+            return !strcmp( argv[i], "--help" )?0:1;
+        }
+    }
+    if( !uiTrials ) {
+        uiTrials = 1;
+    }
+    if( pcOut ) {
+        psCsv = fopen( pcOut, "w" );
+        if( !psCsv ) {
+            perror( pcOut );
+            return 1;
+        }
+        fprintf( psCsv, "impl,op,nodes,size,trials,ns_per_op,cache_misses_per_op\n" );
+    }
+    _probe_open( &stProbe );
+    printf( "# cache miss counters %s\n", (stProbe.m_iFd >= 0)?"on":"not available" );
+    printf( "%-10s %-14s %10s %6s %10s %10s\n", "impl", "op", "nodes", "size", "ns/op", "miss/op" );
+
+    for( ulNodes = 10; ulNodes <= ulMaxNodes; ulNodes *= 10 ) {
+        auiOrder = _order_make( (uint32_t)ulNodes );
+        for( m = 0; m < sizeof( s_auiSize ) / sizeof( s_auiSize[0] ); m++ ) {
+            stPoint.m_uiNodes = (uint32_t)ulNodes;
+            stPoint.m_uiLists = (uint32_t)std::max<uint64_t>( 1, (_SET_NODES + ulNodes - 1) / ulNodes );
+            stPoint.m_uiSize = s_auiSize[m];
+            stPoint.m_puiOrder = auiOrder.data();
+            if( (uint64_t)stPoint.m_uiLists * ulNodes * (s_auiSize[m] + _NODE_OVERHEAD)
+                > ulMemMb * 1024 * 1024 ) {
+                printf( "# skip nodes %llu size %u, over --mem-mb\n",
+                        (unsigned long long)ulNodes, s_auiSize[m] );
+                continue;
+            }
+            for( const auto &rImpl : astImpl ) {
+                for( auto &rTrial : asTrial ) {
+                    rTrial.clear();
+                }
+                for( t = 0; t < uiTrials; t++ ) {
+                    memset( asOut, 0, sizeof( asOut ) );
+                    rImpl.m_pfnRound( &stPoint, &stProbe, asOut );
+                    for( i = 0; i < OP_COUNT; i++ ) {
+                        asTrial[i].push_back( asOut[i] );
+                    }
+                }
+                for( i = 0; i < OP_COUNT; i++ ) {
+                    std::vector<sample_t> &rTrial = asTrial[i];
+                    std::sort( rTrial.begin(), rTrial.end(), _sample_cmp );
+                    const sample_t &rMid = rTrial[rTrial.size() / 2];
+                    if( !rMid.m_ulOps ) {
+                        continue;
+                    }
+                    double dNs = (double)rMid.m_ulNs / rMid.m_ulOps;
+                    double dMiss = (double)rMid.m_ulMiss / rMid.m_ulOps;
+                    printf( "%-10s %-14s %10llu %6u %10.2f ", rImpl.m_pcName, s_apcOp[i],
+                            (unsigned long long)ulNodes, s_auiSize[m], dNs );
+                    if( stProbe.m_iFd >= 0 ) {
+                        printf( "%10.3f\n", dMiss );
+                    } else {
+                        printf( "%10s\n", "-" );
+                    }
+                    if( psCsv ) {
+                        fprintf( psCsv, "%s,%s,%llu,%u,%u,%.3f,", rImpl.m_pcName, s_apcOp[i],
+                                 (unsigned long long)ulNodes, s_auiSize[m], uiTrials, dNs );
+                        if( stProbe.m_iFd >= 0 ) {
+                            fprintf( psCsv, "%.4f", dMiss );
+                        }
+                        fprintf( psCsv, "\n" );
+                    }
+                }
+                fflush( stdout );
+            }
+        }
+    }
+    if( psCsv ) {
+        fclose( psCsv );
+    }
+    if( stProbe.m_iFd >= 0 ) {
+        close( stProbe.m_iFd );
+    }
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,410 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        easylist.hpp
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Typed C++ wrapper over the doubly linked list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *
+ * easylist::List<T> keeps the node layout of list.c: every element lives in
+ * the user data field of a node, right behind its node_head_t. Elements are
+ * constructed in place there and destroyed before their node is freed, so T
+ * does not have to be trivially copyable. The allocator decides where nodes
+ * come from, HeapAllocator uses list_node_alloc and PoolAllocator a node
+ * pool of its own. Requires C++11.
+ *****************************************************************************/
+
+#ifndef _EASYLIST_HPP_
+#define _EASYLIST_HPP_
+
+/* Includes ---------------------------------------------------------------- */
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "list.h"
+
+namespace easylist {
+
+/* Macro Definitions ------------------------------------------------------- */
+
+/* Alignment of the user data field of every node: the one of malloc, unless
+ * the size of the node head is not a multiple of it */
+static constexpr std::size_t NODE_ALIGN =
+    ((sizeof(node_head_t) & (0 - sizeof(node_head_t))) < alignof(std::max_align_t))?
+    (sizeof(node_head_t) & (0 - sizeof(node_head_t))):alignof(std::max_align_t);
+
+/* Type Definitions -------------------------------------------------------- */
+
+/* Allocator taking nodes from list_node_alloc */
+class HeapAllocator {
+public:
+    static constexpr std::size_t ALIGN = NODE_ALIGN;
+
+    /**********************************************************************//**
+     * @fn          create
+     * @param       None
+     * @return      Handle of the created list or NULL if failed
+     * @brief       Create an empty list for the nodes of this allocator
+     *************************************************************************/
+    void *create( void ) { return list_create(); }
+
+    /**********************************************************************//**
+     * @fn          alloc
+     * @param [in]  uiSize - Size of user data field
+     * @return      Pointer to the node or NULL if failed
+     * @brief       Allocate an idle node
+     *************************************************************************/
+    void *alloc( uint32_t uiSize ) { return list_node_alloc( uiSize ); }
+
+    /**********************************************************************//**
+     * @fn          free
+     * @param [in]  pvNode - Pointer to an idle node
+     * @return      None
+     * @brief       Free a node got by alloc
+     *************************************************************************/
+    void free( void *pvNode ) { list_node_free( pvNode ); }
+};
+
+/* Allocator carving nodes of one size from a node pool it owns. The list is
+ * backed by the pool, so clearing it gives all nodes back in one step. */
+template <typename T, uint32_t CHUNK_NODES = 64>
+class PoolAllocator {
+public:
+    static constexpr std::size_t ALIGN = NODE_ALIGN;
+
+    PoolAllocator() : m_pvPool( list_pool_create( sizeof(T), CHUNK_NODES ) )
+    {
+        if( !m_pvPool ) {
+            throw std::bad_alloc();
+        }
+    }
+    PoolAllocator( PoolAllocator &&rOther ) noexcept : m_pvPool( rOther.m_pvPool )
+    {
+        rOther.m_pvPool = NULL;
+    }
+    PoolAllocator &operator=( PoolAllocator &&rOther ) noexcept
+    {
+        std::swap( m_pvPool, rOther.m_pvPool );
+        return *this;
+    }
+    PoolAllocator( const PoolAllocator & ) = delete;
+    PoolAllocator &operator=( const PoolAllocator & ) = delete;
+    ~PoolAllocator() { list_pool_destroy( m_pvPool ); }
+
+    void *create( void ) { return list_create_from( m_pvPool ); }
+    void *alloc( uint32_t ) { return list_node_alloc_from( m_pvPool ); }
+    void free( void *pvNode ) { list_node_free( pvNode ); }
+
+private:
+    void *m_pvPool;
+};
+
+/* Bidirectional iterator over the elements of a list. The end iterator has
+ * no node but still knows its list, so that it can be decremented. */
+template <typename T>
+class ListIterator {
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T *pointer;
+    typedef T &reference;
+
+    ListIterator() : m_pvList( NULL ), m_pvNode( NULL ) {}
+    ListIterator( void *pvList, void *pvNode ) : m_pvList( pvList ), m_pvNode( pvNode ) {}
+    /* Iterator to const from iterator */
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+    ListIterator( const ListIterator<U> &rOther ) : m_pvList( rOther.list() ), m_pvNode( rOther.node() ) {}
+
+    reference operator*() const { return *static_cast<T *>( m_pvNode ); }
+    pointer operator->() const { return static_cast<T *>( m_pvNode ); }
+
+    ListIterator &operator++()
+    {
+        m_pvNode = list_node_next( m_pvNode );
+        return *this;
+    }
+    ListIterator operator++( int )
+    {
+        ListIterator iOld( *this );
+        ++*this;
+        return iOld;
+    }
+    ListIterator &operator--()
+    {
+        m_pvNode = m_pvNode?list_node_prev( m_pvNode ):list_node_last( m_pvList );
+        return *this;
+    }
+    ListIterator operator--( int )
+    {
+        ListIterator iOld( *this );
+        --*this;
+        return iOld;
+    }
+
+    bool operator==( const ListIterator &rOther ) const { return m_pvNode == rOther.m_pvNode; }
+    bool operator!=( const ListIterator &rOther ) const { return m_pvNode != rOther.m_pvNode; }
+
+    void *list( void ) const { return m_pvList; }
+    void *node( void ) const { return m_pvNode; }
+
+private:
+    void *m_pvList;
+    void *m_pvNode;
+};
+
+/* Typed list owning its handle and its elements. Move-only. */
+template <typename T, typename A = HeapAllocator>
+class List {
+    static_assert( alignof(T) <= A::ALIGN, "element over-aligned for the allocator" );
+    static_assert( sizeof(T) <= 0xFFFFFFFFu, "element too large for a node" );
+
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef uint32_t size_type;
+    typedef ListIterator<T> iterator;
+    typedef ListIterator<const T> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    explicit List( A sAlloc = A() ) : m_sAlloc( std::move( sAlloc ) ), m_pvList( m_sAlloc.create() )
+    {
+        if( !m_pvList ) {
+            throw std::bad_alloc();
+        }
+    }
+    List( List &&rOther ) noexcept : m_sAlloc( std::move( rOther.m_sAlloc ) ), m_pvList( rOther.m_pvList )
+    {
+        rOther.m_pvList = NULL;
+    }
+    List &operator=( List &&rOther ) noexcept
+    {
+        std::swap( m_sAlloc, rOther.m_sAlloc );
+        std::swap( m_pvList, rOther.m_pvList );
+        return *this;
+    }
+    List( const List & ) = delete;
+    List &operator=( const List & ) = delete;
+
+    /**********************************************************************//**
+     * @fn          ~List
+     * @brief       Destroy all elements, then free the list with list_destroy.
+     *              The list goes before the allocator, which may own its pool.
+     *************************************************************************/
+    ~List()
+    {
+        if( m_pvList ) {
+            clear();
+            list_destroy( m_pvList );
+        }
+    }
+
+    /**********************************************************************//**
+     * @fn          emplace_back
+     * @param [in]  tArgs - Arguments of a constructor of T
+     * @return      Reference to the new element
+     * @brief       Construct an element in a new node at the end of the list.
+     *              Throws std::bad_alloc if no node is left, an exception
+     *              thrown by the constructor frees the node again.
+     *************************************************************************/
+    template <typename... Args>
+    reference emplace_back( Args &&...tArgs )
+    {
+        void *pvNode = make( std::forward<Args>( tArgs )... );
+        list_add_rear( m_pvList, pvNode );
+        return *static_cast<T *>( pvNode );
+    }
+
+    /**********************************************************************//**
+     * @fn          emplace_front
+     * @param [in]  tArgs - Arguments of a constructor of T
+     * @return      Reference to the new element
+     * @brief       Construct an element in a new node at the beginning of the
+     *              list
+     *************************************************************************/
+    template <typename... Args>
+    reference emplace_front( Args &&...tArgs )
+    {
+        void *pvNode = make( std::forward<Args>( tArgs )... );
+        list_add_front( m_pvList, pvNode );
+        return *static_cast<T *>( pvNode );
+    }
+
+    /**********************************************************************//**
+     * @fn          emplace
+     * @param [in]  iPos  - Position to insert before, may be end()
+     * @param [in]  tArgs - Arguments of a constructor of T
+     * @return      Iterator to the new element
+     * @brief       Construct an element in a new node before the given one
+     *************************************************************************/
+    template <typename... Args>
+    iterator emplace( const_iterator iPos, Args &&...tArgs )
+    {
+        void *pvNode = make( std::forward<Args>( tArgs )... );
+        if( iPos.node() ) {
+            list_insert_before( iPos.node(), pvNode );
+        } else {
+            list_add_rear( m_pvList, pvNode );
+        }
+        return iterator( m_pvList, pvNode );
+    }
+
+    void push_back( const T &rValue ) { emplace_back( rValue ); }
+    void push_back( T &&rValue ) { emplace_back( std::move( rValue ) ); }
+    void push_front( const T &rValue ) { emplace_front( rValue ); }
+    void push_front( T &&rValue ) { emplace_front( std::move( rValue ) ); }
+
+    /**********************************************************************//**
+     * @fn          erase
+     * @param [in]  iPos - Position of an element
+     * @return      Iterator to the element behind the erased one
+     * @brief       Destroy an element and free its node
+     *************************************************************************/
+    iterator erase( const_iterator iPos )
+    {
+        void *pvNode = iPos.node();
+        void *pvNext = list_node_next( pvNode );
+        list_node_del( pvNode );
+        drop( pvNode );
+        return iterator( m_pvList, pvNext );
+    }
+
+    void pop_front( void ) { erase( cbegin() ); }
+    void pop_back( void ) { erase( const_iterator( m_pvList, list_node_last( m_pvList ) ) ); }
+
+    /**********************************************************************//**
+     * @fn          clear
+     * @param       None
+     * @return      None
+     * @brief       Destroy all elements, then free their nodes with
+     *              list_flush. Trivially destructible elements skip the walk.
+     *************************************************************************/
+    void clear( void ) noexcept
+    {
+        void *pvNode;
+        if( !std::is_trivially_destructible<T>::value ) {
+            for( pvNode = list_node_first( m_pvList ); pvNode; pvNode = list_node_next( pvNode ) ) {
+                static_cast<T *>( pvNode )->~T();
+            }
+        }
+        list_flush( m_pvList );
+    }
+
+    /**********************************************************************//**
+     * @fn          sort
+     * @param       None
+     * @return      None
+     * @brief       Stable sort of the elements by operator< with list_sort.
+     *              Nodes are relinked, no element is moved or copied.
+     *************************************************************************/
+    void sort( void ) { list_sort( m_pvList, &List::compare ); }
+
+    reference front( void ) { return *static_cast<T *>( list_node_first( m_pvList ) ); }
+    const_reference front( void ) const { return *static_cast<const T *>( list_node_first( m_pvList ) ); }
+    reference back( void ) { return *static_cast<T *>( list_node_last( m_pvList ) ); }
+    const_reference back( void ) const { return *static_cast<const T *>( list_node_last( m_pvList ) ); }
+
+    size_type size( void ) const { return list_length( m_pvList ); }
+    bool empty( void ) const { return !list_node_first( m_pvList ); }
+
+    iterator begin( void ) { return iterator( m_pvList, list_node_first( m_pvList ) ); }
+    iterator end( void ) { return iterator( m_pvList, NULL ); }
+    const_iterator begin( void ) const { return cbegin(); }
+    const_iterator end( void ) const { return cend(); }
+    const_iterator cbegin( void ) const { return const_iterator( m_pvList, list_node_first( m_pvList ) ); }
+    const_iterator cend( void ) const { return const_iterator( m_pvList, NULL ); }
+    reverse_iterator rbegin( void ) { return reverse_iterator( end() ); }
+    reverse_iterator rend( void ) { return reverse_iterator( begin() ); }
+    const_reverse_iterator rbegin( void ) const { return const_reverse_iterator( cend() ); }
+    const_reverse_iterator rend( void ) const { return const_reverse_iterator( cbegin() ); }
+
+    /* List handle for the C interface. Nodes added through it must hold a
+     * constructed T, nodes deleted through it are no longer destroyed. */
+    void *handle( void ) const { return m_pvList; }
+
+private:
+    /**********************************************************************//**
+     * @fn          make
+     * @param [in]  tArgs - Arguments of a constructor of T
+     * @return      Pointer to an idle node holding the new element
+     * @brief       Allocate a node and construct an element in its user data
+     *              field
+     *************************************************************************/
+    template <typename... Args>
+    void *make( Args &&...tArgs )
+    {
+        void *pvNode = m_sAlloc.alloc( sizeof(T) );
+        if( !pvNode ) {
+            throw std::bad_alloc();
+        }
+        try {
+            ::new( pvNode ) T( std::forward<Args>( tArgs )... );
+        } catch( ... ) {
+            m_sAlloc.free( pvNode );
+            throw;
+        }
+        return pvNode;
+    }
+
+    /**********************************************************************//**
+     * @fn          drop
+     * @param [in]  pvNode - Pointer to an idle node holding an element
+     * @return      None
+     * @brief       Destroy the element and free its node
+     *************************************************************************/
+    void drop( void *pvNode ) noexcept
+    {
+        static_cast<T *>( pvNode )->~T();
+        m_sAlloc.free( pvNode );
+    }
+
+    static int compare( const void *pvNodeA, const void *pvNodeB )
+    {
+        const T &rA = *static_cast<const T *>( pvNodeA );
+        const T &rB = *static_cast<const T *>( pvNodeB );
+        return (rA < rB)?-1:((rB < rA)?1:0);
+    }
+
+    A m_sAlloc;
+    void *m_pvList;
+};
+
+} /* namespace easylist */
+
+#endif /* _EASYLIST_HPP_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -38,284 +38,3515 @@
 
 /* Includes ---------------------------------------------------------------- */
 
-#include "list.h"
+#undef LIST_CFG_INLINE                  /* The real functions are defined here */
+#include "list_priv.h"
 #include "string.h"
 #include "stdlib.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stddef.h>
 
 /* Macro Definitions ------------------------------------------------------- */
 
-#define _HEAD_SIZE   (sizeof(node_head_t))
+#define _NOT_FIRST_NODE(p)  ((_IS_USED_NODE(p))&&(_IS_ANON((p)->m_psList)?\
+                             (!((p)->m_psPrev->m_stHead.m_uiFlags&_NODE_F_ENTRY)):\
+                             ((void*)(p)->m_psPrev!=(void*)(p)->m_psList)))
+#define _NOT_LAST_NODE(p)   ((_IS_USED_NODE(p))&&(_IS_ANON((p)->m_psList)?\
+                             (!((p)->m_psNext->m_stHead.m_uiFlags&_NODE_F_ENTRY)):\
+                             ((void*)(p)->m_psNext!=(void*)(p)->m_psList)))
+#define _IS_EXTERN(p)       ((p)->m_uiFlags&_NODE_F_EXTERN)
+#define _IS_ANON(l)         ((l)==&s_stAnonOwner.m_stEntry)
+#define _OWNER(l)           (((l)->m_uiFlags&_LIST_F_NO_OWNER)?(&s_stAnonOwner.m_stEntry):(l))
+#define _CTRL(l)            ((list_ctrl_t *)(l))
+#define _HAS_HOOK(l)        ((!_IS_ANON(l))&&(_CTRL(l)->m_psIndex||_CTRL(l)->m_psSkip))
+#define _HAS_SKIP(l)        ((!_IS_ANON(l))&&(_CTRL(l)->m_psSkip))
 
-#define _IS_ENTRY(p)        (((p))&&((p)->m_psList==(p)))
-#define _HAS_NODE(p)        (((void*)p)!=((void*)(p)->m_psNext))
-#define _IS_NODE(p)         (((p))&&(p->m_psList!=(p)))
-#define _IS_IDLE_NODE(p)    ((_IS_NODE(p))&&(!(p)->m_psList))
-#define _IS_USED_NODE(p)    ((_IS_NODE(p))&&((p)->m_psList))
-#define _NOT_FIRST_NODE(p)  ((_IS_USED_NODE(p))&&((void*)(p)->m_psPrev!=(void*)(p)->m_psList))
-#define _NOT_LAST_NODE(p)   ((_IS_USED_NODE(p))&&((void*)(p)->m_psNext!=(void*)(p)->m_psList))
-#define _TO_HEAD_ADDR(p)    ((p)?((void*)(p)-_HEAD_SIZE):(NULL))
-#define _TO_USER_ADDR(p)    ((void*)(p)+_HEAD_SIZE)
+#define _ALIGN_UP(n,a)      (((n)+(a)-1)&~((a)-1))
+#define _NODE_ALIGN         (__alignof__(max_align_t))
+#define _NODE_STRIDE(s)     (_ALIGN_UP(_HEAD_SIZE+(s),_NODE_ALIGN))
+#define _POOL_STRIDE(s)     (_ALIGN_UP(sizeof(void*)+_HEAD_SIZE+(s),_NODE_ALIGN))
+#define _SET_POOL(p,s)      (((list_pool_t **)(p))[-1]=(s))
+#define _CHUNK_HEAD_SIZE    (_ALIGN_UP(sizeof(void*)+sizeof(void*),_NODE_ALIGN))
+
+#define _POOL_CHUNK         (0)         /* Pool of list_pool_create */
+#define _POOL_CACHE         (1)         /* Size class of the node cache */
+#define _POOL_BLOCK         (2)         /* Block of list_compact */
+#define _BLOCK_HEAD_SIZE    (_ALIGN_UP(sizeof(list_pool_t)+sizeof(void*),_NODE_ALIGN))
+#define _CAN_MOVE(p)        (!((p)->m_uiFlags&(_NODE_F_EXTERN|_NODE_F_MAPPED)))
+
+#define _CACHE_CLASSES      (9)         /* 16 B up to 4 KB, powers of two */
+#define _CACHE_MIN_SHIFT    (4)
+#define _CACHE_MAX_SIZE     (1u<<(_CACHE_MIN_SHIFT+_CACHE_CLASSES-1))
+#define _CACHE_HEAD_OFF     (_ALIGN_UP(sizeof(void*),_NODE_ALIGN))
+#define _CACHE_BASE(p)      ((void *)(p)-_CACHE_HEAD_OFF)
+#define _MAG_NODES          (64)        /* Nodes per magazine */
+#define _DEPOT_MAGS         (16)        /* Full magazines kept per class */
+
+#define _INDEX_MIN_SLOTS    (16)
+#define _INDEX_FULL(n,m)    ((n)>=((m)+1)/4*3)   /* Load factor 3/4 */
+
+#define _SKIP_MAX_LEVEL     (15)                 /* Levels above the list itself */
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE (0)         /* Plain hint, the address is checked */
+#endif
+#define _MAP_MAGIC          (0x54534C45u)       /* "ELST" */
+#define _MAP_VERSION        (2)
+#define _MAP_ENTRY_OFF      (_ALIGN_UP(sizeof(map_head_t),64))
+#define _MAP_NODE_OFF       (_MAP_ENTRY_OFF+_ALIGN_UP(sizeof(list_ctrl_t),_NODE_ALIGN))
+#define _SAVE_BUF_SIZE      (64 * 1024)
+
+#define _PREFETCH_AHEAD     (4)         /* Nodes fetched ahead of the visitor */
+#define _BATCH_NODES        (16)
+
+#ifdef LIST_CFG_STATS
+#define _CTRL_SIZE          (sizeof(list_stctrl_t))
+#define _REC(l)             (&((list_stctrl_t *)(l))->m_stRec)
+#define _HAS_STATS(l)       ((l)->m_uiFlags&_LIST_F_STATS)
+#define _STATS_ADD(l,f,n)   do { if( _HAS_STATS(l) ) { \
+                                __atomic_fetch_add( &_REC(l)->m_stStats.f, (n), __ATOMIC_RELAXED ); \
+                            } } while( 0 )
+#else
+#define _CTRL_SIZE          (sizeof(list_ctrl_t))
+#define _STATS_ADD(l,f,n)   ((void)(n))
+#define _stats_link(l,p)    ((void)0)
+#define _stats_unlink(l,p)  ((void)0)
+#define _stats_resize(l,o,n) ((void)0)
+#define _stats_flush(l)     ((void)0)
+#define _stats_register(l)  ((void)0)
+#define _stats_unregister(l) ((void)0)
+#endif
+#define _STATS_NAME_SIZE    (32)
+#define _STATS_LINE_SIZE    (256)
+
+#define _SORT_SLOTS         (33)        /* Pending runs of 2^i nodes */
+#define _SORT_MAX_THREADS   (64)
+#define _SORT_MIN_RUN       (4096)      /* Smallest run worth a thread */
 
 /* Type Definitions -------------------------------------------------------- */
 
 typedef struct _NODE_HEAD_T list_entry_t;
 typedef struct _LIST_NODE_T list_node_t;
-typedef struct _NODE_HEAD_T node_head_t;
-
-struct _NODE_HEAD_T {
-    list_node_t *m_psNext;
-    list_node_t *m_psPrev;
-    list_entry_t *m_psList;
-    uint32_t m_uiSize;
-};
+typedef struct _LIST_POOL_T list_pool_t;
 
 struct _LIST_NODE_T {
     node_head_t m_stHead;
     uint8_t m_pData[1];
 };
 
-/* Function Definitions ---------------------------------------------------- */
+typedef struct _SORT_JOB_T sort_job_t;
+
+struct _SORT_JOB_T {
+    node_head_t *m_psChain;     /* NULL terminated chain by m_psNext */
+    node_head_t *m_psOther;     /* Chain to merge with, NULL to sort */
+    list_cmp_t m_pfnCmp;
+};
+
+struct _LIST_POOL_T {
+    node_head_t *m_psFree;      /* Idle nodes chained by m_psNext */
+    void *m_pvChunks;           /* Chunks chained by their first word */
+    uint32_t m_uiNodeSize;
+    uint32_t m_uiChunkNodes;    /* Nodes still in use for a block */
+    uint32_t m_uiKind;
+};
+
+typedef struct _LIST_INDEX_T list_index_t;
+typedef struct _INDEX_SLOT_T index_slot_t;
+typedef struct _SKIP_LINK_T skip_link_t;
+typedef struct _SKIP_TOWER_T skip_tower_t;
+typedef struct _LIST_SKIP_T list_skip_t;
+
+struct _INDEX_SLOT_T {
+    node_head_t *m_psNode;      /* NULL for an empty slot */
+    uint32_t m_uiHash;
+};
+
+/* Open addressing hash table with linear probing. Deleting shifts the
+ * following slots back, so there are no tombstones and no rehash on churn. */
+struct _LIST_INDEX_T {
+    list_key_t m_pfnKey;
+    list_hash_t m_pfnHash;
+    list_eq_t m_pfnEq;
+    index_slot_t *m_psSlot;
+    uint32_t m_uiMask;
+    uint32_t m_uiCount;
+    bool m_bStale;              /* Out of memory once, rebuild on lookup */
+    bool m_bShared;             /* Slots live in a pool chunk, see list_reserve */
+};
+
+/* Forward link of a skip level with the number of list steps it spans */
+struct _SKIP_LINK_T {
+    skip_tower_t *m_psNext;     /* NULL at the end of a level */
+    uint32_t m_uiWidth;
+};
+
+/* Levels of a node above the list itself, m_astLink[l - 1] is level l */
+struct _SKIP_TOWER_T {
+    node_head_t *m_psNode;      /* Node carrying the tower */
+    uint32_t m_uiHeight;        /* Including the list, so at least 2 */
+    skip_link_t m_astLink[1];
+};
+
+/* Order statistic skip list over the nodes of a list. Level 0 is the list
+ * itself, so only about a quarter of the nodes carry a tower. The towers are
+ * found by node address in a table of their own rather than through the
+ * node head, so lists without a skip list do not pay for it. Position 0 is
+ * the head and position m_uiCount + 1 the end of the list. */
+struct _LIST_SKIP_T {
+    uint32_t m_uiLevel;         /* Highest level in use */
+    uint32_t m_uiCount;
+    uint32_t m_uiSeed;
+    bool m_bStale;              /* Nodes were reordered, rebuild on query */
+    skip_tower_t **m_ppsTower;  /* Towers by node, linear probing */
+    uint32_t m_uiMask;
+    uint32_t m_uiTowers;
+    skip_link_t m_astHead[_SKIP_MAX_LEVEL];
+};
+
+#ifdef LIST_CFG_STATS
+typedef struct _STATS_REC_T stats_rec_t;
+typedef struct _LIST_STCTRL_T list_stctrl_t;
+
+/* Counters of a list and its place in the registry of live lists */
+struct _STATS_REC_T {
+    stats_rec_t *m_psNext;
+    stats_rec_t *m_psPrev;
+    list_stats_t m_stStats;
+    char m_acName[_STATS_NAME_SIZE];
+};
+
+/* Control block allocated instead of list_ctrl_t when counting. The record
+ * stays out of list_ctrl_t, which is also the layout of list images. */
+struct _LIST_STCTRL_T {
+    list_ctrl_t m_stCtrl;
+    stats_rec_t m_stRec;
+};
+#endif
+
+typedef struct _MAP_HEAD_T map_head_t;
+typedef struct _SAVE_BUF_T save_buf_t;
+
+/* Head of a list image. Links in the image are the addresses they would
+ * have with the image mapped at m_ulBase, so mapping it there needs no
+ * fixing up at all. */
+struct _MAP_HEAD_T {
+    uint32_t m_uiMagic;
+    uint32_t m_uiVersion;
+    uint32_t m_uiHeadSize;      /* sizeof(node_head_t) of the writer */
+    uint32_t m_uiPtrSize;
+    uint64_t m_ulBase;          /* 0 for no preferred address */
+    uint64_t m_ulSize;          /* Size of the whole image */
+};
+
+struct _SAVE_BUF_T {
+    uint8_t *m_pBuf;
+    uint32_t m_uiUsed;
+    int m_iFd;
+    bool m_bOk;
+};
+
+typedef struct _NODE_MAG_T node_mag_t;
+typedef struct _NODE_DEPOT_T node_depot_t;
+typedef struct _NODE_CACHE_T node_cache_t;
+
+/* Magazine of idle nodes of one size class */
+struct _NODE_MAG_T {
+    node_mag_t *m_psNext;
+    uint32_t m_uiCount;
+    node_head_t *m_apsNode[_MAG_NODES];
+};
+
+/* Shared store of magazines of one size class */
+struct _NODE_DEPOT_T {
+    pthread_mutex_t m_sLock;
+    node_mag_t *m_psFull;
+    node_mag_t *m_psEmpty;
+    uint32_t m_uiFull;
+};
+
+/* Per-thread cache, a loaded and a previous magazine per size class. A
+ * thread goes to the depot only when both are empty on alloc or both are
+ * full on free, so the depot lock is taken once per magazine at most. */
+struct _NODE_CACHE_T {
+    node_mag_t *m_apsLoaded[_CACHE_CLASSES];
+    node_mag_t *m_apsPrev[_CACHE_CLASSES];
+};
+
+/* Local Variables --------------------------------------------------------- */
+
+/* Owner recorded by the nodes of lists created with LIST_OPT_NO_OWNER. It is
+ * not an entry, only a marker telling the nodes do not know their list. Its
+ * flag lets list_inline.h tell it apart without knowing its address, and its
+ * empty control block lets the pool checks read it like a list. */
+static list_ctrl_t s_stAnonOwner = { .m_stEntry = { .m_uiFlags = _LIST_F_NO_OWNER } };
+
+#ifdef LIST_CFG_STATS
+/* Registry of the counted lists, a circular list through the records */
+static stats_rec_t s_stStatsReg = { .m_psNext = &s_stStatsReg, .m_psPrev = &s_stStatsReg };
+static pthread_mutex_t s_sStatsLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Node cache of list_node_alloc, see list_node_cache_enable */
+static bool s_bCacheOn;
+static list_pool_t s_astCacheClass[_CACHE_CLASSES];
+static node_depot_t s_astDepot[_CACHE_CLASSES];
+static pthread_once_t s_sCacheOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_sCacheKey;
+static __thread node_cache_t *s_psCache;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _pool_grow
+ * @param [in]  psPool  - Pointer to a pool
+ * @param [in]  uiNodes - Number of nodes to carve
+ * @param [in]  ulExtra - Bytes to allocate behind the nodes in the chunk
+ * @return      Pointer to the extra bytes, which is the end of the chunk
+ *              without them, or NULL if out of memory
+ * @brief       Carve a new chunk of nodes and push them to the free list
+ *****************************************************************************/
+static void *_pool_grow( list_pool_t *psPool, uint32_t uiNodes, size_t ulExtra )
+{
+    uint32_t uiStride = _POOL_STRIDE(psPool->m_uiNodeSize);
+    void *pvChunk = malloc( _CHUNK_HEAD_SIZE + (size_t)uiStride * uiNodes + ulExtra );
+    node_head_t *psHead;
+    uint32_t i;
+    if( !pvChunk ) {
+        return NULL;
+    }
+    *(void **)pvChunk = psPool->m_pvChunks;
+    psPool->m_pvChunks = pvChunk;
+    for( i = uiNodes; i > 0; i-- ) {
+        psHead = pvChunk + _CHUNK_HEAD_SIZE + (size_t)uiStride * (i - 1);
+        _SET_POOL(psHead, psPool);
+        psHead->m_uiFlags = _NODE_F_POOLED;
+        psHead->m_psNext = (void *)psPool->m_psFree;
+        psPool->m_psFree = psHead;
+    }
+    return pvChunk + _CHUNK_HEAD_SIZE + (size_t)uiStride * uiNodes;
+}
+
+/**************************************************************************//**
+ * @fn          _depot_push
+ * @param [in]  uiClass  - Size class
+ * @param [in]  psMag    - Magazine holding idle nodes
+ * @param [out] ppsEmpty - Empty magazine of the depot if any, NULL if not
+ *                         wanted
+ * @return      true if the depot kept the magazine, false if it was full
+ *              and the nodes were freed instead
+ * @brief       Hand a magazine to the depot without allocating memory. The
+ *              footprint is bounded by freeing the nodes of a magazine the
+ *              depot has no room for, which leaves it to the caller.
+ *****************************************************************************/
+static bool _depot_push( uint32_t uiClass, node_mag_t *psMag, node_mag_t **ppsEmpty )
+{
+    node_depot_t *psDepot = &s_astDepot[uiClass];
+    bool bKept = false;
+    pthread_mutex_lock( &psDepot->m_sLock );
+    if( psDepot->m_uiFull < _DEPOT_MAGS ) {
+        psMag->m_psNext = psDepot->m_psFull;
+        psDepot->m_psFull = psMag;
+        __atomic_store_n( &psDepot->m_uiFull, psDepot->m_uiFull + 1, __ATOMIC_RELAXED );
+        if( ppsEmpty ) {
+            *ppsEmpty = psDepot->m_psEmpty;
+            if( *ppsEmpty ) {
+                psDepot->m_psEmpty = (*ppsEmpty)->m_psNext;
+            }
+        }
+        bKept = true;
+    }
+    pthread_mutex_unlock( &psDepot->m_sLock );
+    if( !bKept ) {
+        while( psMag->m_uiCount ) {
+            free( _CACHE_BASE(psMag->m_apsNode[--psMag->m_uiCount]) );
+        }
+    }
+    return bKept;
+}
+
+/**************************************************************************//**
+ * @fn          _depot_put
+ * @param [in]  uiClass - Size class
+ * @param [in]  psMag   - Magazine holding idle nodes
+ * @return      An empty magazine
+ * @brief       Hand a magazine to the depot and get an empty one back
+ *****************************************************************************/
+static node_mag_t *_depot_put( uint32_t uiClass, node_mag_t *psMag )
+{
+    node_depot_t *psDepot = &s_astDepot[uiClass];
+    node_mag_t *psEmpty = NULL;
+    if( !_depot_push( uiClass, psMag, &psEmpty ) ) {
+        return psMag;
+    }
+    if( !psEmpty ) {
+        psEmpty = malloc( sizeof( node_mag_t ) );
+    }
+    if( !psEmpty ) {
+        /* Out of memory, take a magazine back and give its nodes to the
+         * heap. The depot holds one at least, since a full magazine taken
+         * out always leaves an empty one behind. */
+        pthread_mutex_lock( &psDepot->m_sLock );
+        if( (psEmpty = psDepot->m_psEmpty) ) {
+            psDepot->m_psEmpty = psEmpty->m_psNext;
+        } else {
+            psEmpty = psDepot->m_psFull;
+            psDepot->m_psFull = psEmpty->m_psNext;
+            __atomic_store_n( &psDepot->m_uiFull, psDepot->m_uiFull - 1, __ATOMIC_RELAXED );
+        }
+        pthread_mutex_unlock( &psDepot->m_sLock );
+        while( psEmpty->m_uiCount ) {
+            free( _CACHE_BASE(psEmpty->m_apsNode[--psEmpty->m_uiCount]) );
+        }
+    }
+    psEmpty->m_uiCount = 0;
+    return psEmpty;
+}
+
+/**************************************************************************//**
+ * @fn          _depot_get
+ * @param [in]  uiClass - Size class
+ * @param [in]  psMag   - Empty magazine
+ * @return      A magazine holding idle nodes or NULL if the depot has none
+ * @brief       Trade an empty magazine for a full one of the depot
+ *****************************************************************************/
+static node_mag_t *_depot_get( uint32_t uiClass, node_mag_t *psMag )
+{
+    node_depot_t *psDepot = &s_astDepot[uiClass];
+    node_mag_t *psFull = NULL;
+    if( !__atomic_load_n( &psDepot->m_uiFull, __ATOMIC_RELAXED ) ) {
+        return NULL;
+    }
+    pthread_mutex_lock( &psDepot->m_sLock );
+    if( psDepot->m_psFull ) {
+        psFull = psDepot->m_psFull;
+        psDepot->m_psFull = psFull->m_psNext;
+        __atomic_store_n( &psDepot->m_uiFull, psDepot->m_uiFull - 1, __ATOMIC_RELAXED );
+        psMag->m_psNext = psDepot->m_psEmpty;
+        psDepot->m_psEmpty = psMag;
+    }
+    pthread_mutex_unlock( &psDepot->m_sLock );
+    return psFull;
+}
+
+/**************************************************************************//**
+ * @fn          _cache_exit
+ * @param [in]  pvCache - Cache of an exiting thread
+ * @return      None
+ * @brief       Hand the magazines of an exiting thread to the depots. Only
+ *              the ones holding nodes are kept, nothing is allocated.
+ *****************************************************************************/
+static void _cache_exit( void *pvCache )
+{
+    node_cache_t *psCache = pvCache;
+    node_mag_t *apsMag[2];
+    uint32_t i;
+    uint32_t j;
+    for( i = 0; i < _CACHE_CLASSES; i++ ) {
+        apsMag[0] = psCache->m_apsLoaded[i];
+        apsMag[1] = psCache->m_apsPrev[i];
+        for( j = 0; j < 2; j++ ) {
+            /* A magazine the depot keeps is not freed */
+            if( !apsMag[j] || !apsMag[j]->m_uiCount || !_depot_push( i, apsMag[j], NULL ) ) {
+                free( apsMag[j] );
+            }
+        }
+    }
+    free( psCache );
+    s_psCache = NULL;
+}
+
+/**************************************************************************//**
+ * @fn          _cache_init
+ * @param       None
+ * @return      None
+ * @brief       Set up size classes and depots, once per process
+ *****************************************************************************/
+static void _cache_init( void )
+{
+    uint32_t i;
+    pthread_key_create( &s_sCacheKey, _cache_exit );
+    for( i = 0; i < _CACHE_CLASSES; i++ ) {
+        s_astCacheClass[i].m_uiNodeSize = 1u << (_CACHE_MIN_SHIFT + i);
+        s_astCacheClass[i].m_uiKind = _POOL_CACHE;
+        pthread_mutex_init( &s_astDepot[i].m_sLock, NULL );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _cache_get
+ * @param [in]  uiClass - Size class to get magazines for
+ * @return      Cache of the calling thread or NULL if out of memory
+ * @brief       Get the cache of the calling thread, creating it and the
+ *              magazines of a size class on first use
+ *****************************************************************************/
+static node_cache_t *_cache_get( uint32_t uiClass )
+{
+    node_cache_t *psCache = s_psCache;
+    if( !psCache ) {
+        psCache = calloc( 1, sizeof( node_cache_t ) );
+        if( !psCache ) {
+            return NULL;
+        }
+        pthread_setspecific( s_sCacheKey, psCache );
+        s_psCache = psCache;
+    }
+    if( !psCache->m_apsLoaded[uiClass] ) {
+        psCache->m_apsLoaded[uiClass] = calloc( 1, sizeof( node_mag_t ) );
+        psCache->m_apsPrev[uiClass] = calloc( 1, sizeof( node_mag_t ) );
+        if( !psCache->m_apsLoaded[uiClass] || !psCache->m_apsPrev[uiClass] ) {
+            free( psCache->m_apsLoaded[uiClass] );
+            free( psCache->m_apsPrev[uiClass] );
+            psCache->m_apsLoaded[uiClass] = NULL;
+            psCache->m_apsPrev[uiClass] = NULL;
+            return NULL;
+        }
+    }
+    return psCache;
+}
+
+/**************************************************************************//**
+ * @fn          _cache_class
+ * @param [in]  uiSize - Size of user data field
+ * @return      Size class or _CACHE_CLASSES if too large for the cache
+ * @brief       Get the smallest size class holding a user data field
+ *****************************************************************************/
+static uint32_t _cache_class( uint32_t uiSize )
+{
+    uint32_t uiClass = 0;
+    if( uiSize > _CACHE_MAX_SIZE ) {
+        return _CACHE_CLASSES;
+    }
+    while( (1u << (_CACHE_MIN_SHIFT + uiClass)) < uiSize ) {
+        uiClass++;
+    }
+    return uiClass;
+}
+
+/**************************************************************************//**
+ * @fn          _cache_alloc
+ * @param [in]  uiClass - Size class
+ * @return      Pointer to an idle node head or NULL if failed
+ * @brief       Take a node of a size class from the cache of the calling
+ *              thread, refilling it from the depot or the heap when empty
+ *****************************************************************************/
+static node_head_t *_cache_alloc( uint32_t uiClass )
+{
+    node_cache_t *psCache = _cache_get( uiClass );
+    node_mag_t *psMag;
+    node_mag_t *psFull;
+    node_head_t *psHead;
+    if( !psCache ) {
+        return NULL;
+    }
+    psMag = psCache->m_apsLoaded[uiClass];
+    if( !psMag->m_uiCount ) {
+        if( psCache->m_apsPrev[uiClass]->m_uiCount ) {
+            psCache->m_apsLoaded[uiClass] = psCache->m_apsPrev[uiClass];
+            psCache->m_apsPrev[uiClass] = psMag;
+        } else if( (psFull = _depot_get( uiClass, psMag )) ) {
+            psCache->m_apsLoaded[uiClass] = psFull;
+        } else {
+            psHead = malloc( _CACHE_HEAD_OFF + _HEAD_SIZE + s_astCacheClass[uiClass].m_uiNodeSize );
+            if( psHead ) {
+                psHead = (void *)psHead + _CACHE_HEAD_OFF;
+                _SET_POOL(psHead, &s_astCacheClass[uiClass]);
+                psHead->m_uiFlags = _NODE_F_POOLED;
+            }
+            return psHead;
+        }
+        psMag = psCache->m_apsLoaded[uiClass];
+    }
+    return psMag->m_apsNode[--psMag->m_uiCount];
+}
+
+/**************************************************************************//**
+ * @fn          _cache_free_chain
+ * @param [in]  uiClass - Size class
+ * @param [in]  psHead  - First of idle node heads of the size class, chained
+ *                        through m_psNext and ending with NULL
+ * @return      None
+ * @brief       Put a chain of nodes into the cache of the calling thread.
+ *              The cache is looked up once, and a magazine is filled up in
+ *              one go and handed to the depot as a whole when full.
+ *****************************************************************************/
+static void _cache_free_chain( uint32_t uiClass, node_head_t *psHead )
+{
+    node_cache_t *psCache = _cache_get( uiClass );
+    node_mag_t *psMag;
+    node_head_t *psNext;
+    if( !psCache ) {
+        for( ; psHead; psHead = psNext ) {
+            psNext = (void *)psHead->m_psNext;
+            free( _CACHE_BASE(psHead) );
+        }
+        return;
+    }
+    while( psHead ) {
+        psMag = psCache->m_apsLoaded[uiClass];
+        if( psMag->m_uiCount == _MAG_NODES ) {
+            if( !psCache->m_apsPrev[uiClass]->m_uiCount ) {
+                psCache->m_apsLoaded[uiClass] = psCache->m_apsPrev[uiClass];
+                psCache->m_apsPrev[uiClass] = psMag;
+            } else {
+                psCache->m_apsLoaded[uiClass] = _depot_put( uiClass, psMag );
+            }
+            psMag = psCache->m_apsLoaded[uiClass];
+        }
+        for( ; psHead && psMag->m_uiCount < _MAG_NODES; psHead = psNext ) {
+            psNext = (void *)psHead->m_psNext;
+            psMag->m_apsNode[psMag->m_uiCount++] = psHead;
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _cache_free
+ * @param [in]  psHead - Pointer to a node head of a size class
+ * @return      None
+ * @brief       Put a node into the cache of the calling thread, handing a
+ *              full magazine to the depot when needed
+ *****************************************************************************/
+static void _cache_free( node_head_t *psHead )
+{
+    psHead->m_psNext = NULL;
+    _cache_free_chain( _NODE_POOL(psHead) - s_astCacheClass, psHead );
+}
+
+/**************************************************************************//**
+ * @fn          _index_mix
+ * @param [in]  uiHash - Hash value given by the user
+ * @return      Mixed hash value
+ * @brief       Spread the bits of a user hash so that low bits pick slots well
+ *****************************************************************************/
+static inline uint32_t _index_mix( uint32_t uiHash )
+{
+    uiHash ^= uiHash >> 16;
+    uiHash *= 0x85ebca6bu;
+    uiHash ^= uiHash >> 13;
+    uiHash *= 0xc2b2ae35u;
+    uiHash ^= uiHash >> 16;
+    return uiHash;
+}
+
+/**************************************************************************//**
+ * @fn          _index_place
+ * @param [in]  psIndex - Pointer to an index with a free slot
+ * @param [in]  psHead  - Pointer to a node head
+ * @param [in]  uiHash  - Mixed hash of the key of the node
+ * @return      None
+ * @brief       Put a node into the first free slot of its probe sequence
+ *****************************************************************************/
+static void _index_place( list_index_t *psIndex, node_head_t *psHead, uint32_t uiHash )
+{
+    uint32_t i = uiHash & psIndex->m_uiMask;
+    while( psIndex->m_psSlot[i].m_psNode ) {
+        i = (i + 1) & psIndex->m_uiMask;
+    }
+    psIndex->m_psSlot[i].m_psNode = psHead;
+    psIndex->m_psSlot[i].m_uiHash = uiHash;
+    psIndex->m_uiCount++;
+}
+
+/**************************************************************************//**
+ * @fn          _index_resize
+ * @param [in]  psIndex - Pointer to an index
+ * @param [in]  uiSlots - New number of slots, a power of two above count
+ * @param [in]  psSlot  - Zeroed table of a pool chunk or NULL to allocate one
+ * @return      true if resized, false if out of memory
+ * @brief       Move all nodes of an index into a new table
+ *****************************************************************************/
+static bool _index_resize( list_index_t *psIndex, uint32_t uiSlots, index_slot_t *psSlot )
+{
+    index_slot_t *psOld = psIndex->m_psSlot;
+    uint32_t uiOld = psOld?(psIndex->m_uiMask + 1):0;
+    bool bShared = psIndex->m_bShared;
+    uint32_t i;
+    psIndex->m_psSlot = psSlot?psSlot:calloc( uiSlots, sizeof( index_slot_t ) );
+    if( !psIndex->m_psSlot ) {
+        psIndex->m_psSlot = psOld;
+        return false;
+    }
+    psIndex->m_bShared = (psSlot != NULL);
+    psIndex->m_uiMask = uiSlots - 1;
+    psIndex->m_uiCount = 0;
+    for( i = 0; i < uiOld; i++ ) {
+        if( psOld[i].m_psNode ) {
+            _index_place( psIndex, psOld[i].m_psNode, psOld[i].m_uiHash );
+        }
+    }
+    if( !bShared ) {
+        free( psOld );
+    }
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          _index_hash
+ * @param [in]  psIndex - Pointer to an index
+ * @param [in]  psHead  - Pointer to a node head
+ * @return      Mixed hash of the key of the node
+ * @brief       Hash the key of a node
+ *****************************************************************************/
+static inline uint32_t _index_hash( list_index_t *psIndex, node_head_t *psHead )
+{
+    return _index_mix( psIndex->m_pfnHash( psIndex->m_pfnKey( _TO_USER_ADDR(psHead) ) ) );
+}
+
+/**************************************************************************//**
+ * @fn          _index_insert
+ * @param [in]  psIndex - Pointer to an index
+ * @param [in]  psHead  - Pointer to a node head joining the list
+ * @return      None
+ * @brief       Add a node to an index, growing the table when needed. When
+ *              out of memory the index turns stale instead of losing track.
+ *****************************************************************************/
+static void _index_insert( list_index_t *psIndex, node_head_t *psHead )
+{
+    if( psIndex->m_bStale ) {
+        return;
+    }
+    if( _INDEX_FULL(psIndex->m_uiCount + 1, psIndex->m_uiMask + 1)
+        && !_index_resize( psIndex, (psIndex->m_uiMask + 1) * 2, NULL )
+        && psIndex->m_uiCount + 1 > psIndex->m_uiMask ) {
+        psIndex->m_bStale = true;
+        return;
+    }
+    _index_place( psIndex, psHead, _index_hash( psIndex, psHead ) );
+}
+
+/**************************************************************************//**
+ * @fn          _index_remove
+ * @param [in]  psIndex - Pointer to an index
+ * @param [in]  psHead  - Pointer to a node head leaving the list
+ * @return      None
+ * @brief       Remove a node from an index and shift the following slots of
+ *              the cluster back into the hole
+ *****************************************************************************/
+static void _index_remove( list_index_t *psIndex, node_head_t *psHead )
+{
+    index_slot_t *psSlot = psIndex->m_psSlot;
+    uint32_t uiMask = psIndex->m_uiMask;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    if( psIndex->m_bStale ) {
+        return;
+    }
+    for( i = _index_hash( psIndex, psHead ) & uiMask; psSlot[i].m_psNode != psHead; i = (i + 1) & uiMask ) {
+        if( !psSlot[i].m_psNode ) {
+            return;
+        }
+    }
+    for( j = (i + 1) & uiMask; psSlot[j].m_psNode; j = (j + 1) & uiMask ) {
+        /* Move slot j back unless its home lies cyclically in (i, j] */
+        k = psSlot[j].m_uiHash & uiMask;
+        if( (i <= j)?((i < k) && (k <= j)):((i < k) || (k <= j)) ) {
+            continue;
+        }
+        psSlot[i] = psSlot[j];
+        i = j;
+    }
+    psSlot[i].m_psNode = NULL;
+    psIndex->m_uiCount--;
+}
+
+/**************************************************************************//**
+ * @fn          _index_move
+ * @param [in]  psIndex - Pointer to an index
+ * @param [in]  psOld   - Pointer to a node head in the index
+ * @param [in]  psNew   - Pointer to a copy of the node with the same key
+ * @return      None
+ * @brief       Point the slot of a node at its copy
+ *****************************************************************************/
+static void _index_move( list_index_t *psIndex, node_head_t *psOld, node_head_t *psNew )
+{
+    uint32_t i;
+    if( psIndex->m_bStale ) {
+        return;
+    }
+    for( i = _index_hash( psIndex, psNew ) & psIndex->m_uiMask; psIndex->m_psSlot[i].m_psNode;
+         i = (i + 1) & psIndex->m_uiMask ) {
+        if( psIndex->m_psSlot[i].m_psNode == psOld ) {
+            psIndex->m_psSlot[i].m_psNode = psNew;
+            return;
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _index_clear
+ * @param [in]  psIndex - Pointer to an index
+ * @return      None
+ * @brief       Empty an index, keeping its table for the next nodes
+ *****************************************************************************/
+static void _index_clear( list_index_t *psIndex )
+{
+    if( psIndex->m_psSlot ) {
+        memset( psIndex->m_psSlot, 0, (psIndex->m_uiMask + 1) * sizeof( index_slot_t ) );
+    }
+    psIndex->m_uiCount = 0;
+    psIndex->m_bStale = (psIndex->m_psSlot == NULL);
+}
+
+/**************************************************************************//**
+ * @fn          _index_rebuild
+ * @param [in]  psList  - Pointer to a list entry
+ * @param [in]  psIndex - Pointer to an index of the list
+ * @return      true if built, false if out of memory
+ * @brief       Build an index from all nodes of a list
+ *****************************************************************************/
+static bool _index_rebuild( list_entry_t *psList, list_index_t *psIndex )
+{
+    node_head_t *psHead;
+    uint32_t uiSlots = _INDEX_MIN_SLOTS;
+    while( _INDEX_FULL(psList->m_uiSize, uiSlots) ) {
+        uiSlots *= 2;
+    }
+    if( !psIndex->m_bShared ) {
+        free( psIndex->m_psSlot );
+    }
+    psIndex->m_psSlot = NULL;
+    psIndex->m_bShared = false;
+    if( !_index_resize( psIndex, uiSlots, NULL ) ) {
+        psIndex->m_bStale = true;
+        return false;
+    }
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        _index_place( psIndex, psHead, _index_hash( psIndex, psHead ) );
+    }
+    psIndex->m_bStale = false;
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_link
+ * @param [in]  psSkip  - Pointer to a skip list
+ * @param [in]  psTower - Pointer to a tower with the level, NULL for the head
+ * @param [in]  uiLevel - Level from 1
+ * @return      Pointer to the forward link of the tower at the level
+ * @brief       Get a forward link of a tower or of the head
+ *****************************************************************************/
+static inline skip_link_t *_skip_link( list_skip_t *psSkip, skip_tower_t *psTower, uint32_t uiLevel )
+{
+    return psTower?&psTower->m_astLink[uiLevel - 1]:&psSkip->m_astHead[uiLevel - 1];
+}
+
+/**************************************************************************//**
+ * @fn          _skip_hash
+ * @param [in]  psSkip - Pointer to a skip list with a tower table
+ * @param [in]  psHead - Pointer to a node head
+ * @return      Home slot of the tower of the node
+ * @brief       Hash the address of a node into the tower table
+ *****************************************************************************/
+static inline uint32_t _skip_hash( list_skip_t *psSkip, node_head_t *psHead )
+{
+    return (uint32_t)(((uint64_t)(uintptr_t)psHead * 0x9E3779B97F4A7C15ull) >> 32) & psSkip->m_uiMask;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_find
+ * @param [in]  psSkip - Pointer to a skip list
+ * @param [in]  psHead - Pointer to a node head flagged with _NODE_F_TOWER
+ * @return      Slot of the tower of the node
+ * @brief       Look up the tower of a node
+ *****************************************************************************/
+static uint32_t _skip_find( list_skip_t *psSkip, node_head_t *psHead )
+{
+    uint32_t i = _skip_hash( psSkip, psHead );
+    while( psSkip->m_ppsTower[i]->m_psNode != psHead ) {
+        i = (i + 1) & psSkip->m_uiMask;
+    }
+    return i;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_place
+ * @param [in]  psSkip  - Pointer to a skip list with a free slot
+ * @param [in]  psTower - Pointer to a tower
+ * @return      None
+ * @brief       Put a tower into the first free slot of its probe sequence
+ *****************************************************************************/
+static void _skip_place( list_skip_t *psSkip, skip_tower_t *psTower )
+{
+    uint32_t i = _skip_hash( psSkip, psTower->m_psNode );
+    while( psSkip->m_ppsTower[i] ) {
+        i = (i + 1) & psSkip->m_uiMask;
+    }
+    psSkip->m_ppsTower[i] = psTower;
+    psSkip->m_uiTowers++;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_resize
+ * @param [in]  psSkip  - Pointer to a skip list
+ * @param [in]  uiSlots - New number of slots, a power of two above count
+ * @return      true if resized, false if out of memory
+ * @brief       Move all towers of a skip list into a new table
+ *****************************************************************************/
+static bool _skip_resize( list_skip_t *psSkip, uint32_t uiSlots )
+{
+    skip_tower_t **ppsOld = psSkip->m_ppsTower;
+    uint32_t uiOld = ppsOld?(psSkip->m_uiMask + 1):0;
+    uint32_t i;
+    psSkip->m_ppsTower = calloc( uiSlots, sizeof( skip_tower_t * ) );
+    if( !psSkip->m_ppsTower ) {
+        psSkip->m_ppsTower = ppsOld;
+        return false;
+    }
+    psSkip->m_uiMask = uiSlots - 1;
+    psSkip->m_uiTowers = 0;
+    for( i = 0; i < uiOld; i++ ) {
+        if( ppsOld[i] ) {
+            _skip_place( psSkip, ppsOld[i] );
+        }
+    }
+    free( ppsOld );
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_height
+ * @param [in]  psSkip - Pointer to a skip list
+ * @return      Random height with P(h > k) = 4^-(k - 1)
+ * @brief       Draw the height of a new tower
+ *****************************************************************************/
+static uint32_t _skip_height( list_skip_t *psSkip )
+{
+    uint32_t uiRand = psSkip->m_uiSeed;
+    uint32_t uiHeight = 1;
+    uiRand ^= uiRand << 13;
+    uiRand ^= uiRand >> 17;
+    uiRand ^= uiRand << 5;
+    psSkip->m_uiSeed = uiRand;
+    while( !(uiRand & 3) && uiHeight <= _SKIP_MAX_LEVEL ) {
+        uiHeight++;
+        uiRand = (uiRand >> 2) | 0x80000000u;
+    }
+    return uiHeight;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_tower
+ * @param [in]  psSkip   - Pointer to a skip list
+ * @param [in]  psHead   - Pointer to a node head without a tower
+ * @param [in]  uiHeight - Height of the tower
+ * @return      Pointer to the tower or NULL for a node of height 1
+ * @brief       Give a node a tower. A lower node only costs some speed, so
+ *              running out of memory here is not an error.
+ *****************************************************************************/
+static skip_tower_t *_skip_tower( list_skip_t *psSkip, node_head_t *psHead, uint32_t uiHeight )
+{
+    skip_tower_t *psTower;
+    if( uiHeight < 2 ) {
+        return NULL;
+    }
+    if( _INDEX_FULL(psSkip->m_uiTowers + 1, psSkip->m_uiMask + 1)
+        && !_skip_resize( psSkip, psSkip->m_ppsTower?(psSkip->m_uiMask + 1) * 2:_INDEX_MIN_SLOTS ) ) {
+        return NULL;
+    }
+    psTower = malloc( sizeof( skip_tower_t ) + (uiHeight - 2) * sizeof( skip_link_t ) );
+    if( !psTower ) {
+        return NULL;
+    }
+    psTower->m_psNode = psHead;
+    psTower->m_uiHeight = uiHeight;
+    _skip_place( psSkip, psTower );
+    psHead->m_uiFlags |= _NODE_F_TOWER;
+    return psTower;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_untower
+ * @param [in]  psSkip - Pointer to a skip list
+ * @param [in]  psHead - Pointer to a node head
+ * @return      None
+ * @brief       Take the tower off a node if it has one, shifting the
+ *              following slots of the cluster back into the hole
+ *****************************************************************************/
+static void _skip_untower( list_skip_t *psSkip, node_head_t *psHead )
+{
+    skip_tower_t **ppsSlot = psSkip->m_ppsTower;
+    uint32_t uiMask = psSkip->m_uiMask;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    if( !(psHead->m_uiFlags & _NODE_F_TOWER) ) {
+        return;
+    }
+    i = _skip_find( psSkip, psHead );
+    free( ppsSlot[i] );
+    for( j = (i + 1) & uiMask; ppsSlot[j]; j = (j + 1) & uiMask ) {
+        /* Move slot j back unless its home lies cyclically in (i, j] */
+        k = _skip_hash( psSkip, ppsSlot[j]->m_psNode );
+        if( (i <= j)?((i < k) && (k <= j)):((i < k) || (k <= j)) ) {
+            continue;
+        }
+        ppsSlot[i] = ppsSlot[j];
+        i = j;
+    }
+    ppsSlot[i] = NULL;
+    psSkip->m_uiTowers--;
+    psHead->m_uiFlags &= ~_NODE_F_TOWER;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_rank
+ * @param [in]  psSkip - Pointer to a skip list
+ * @param [in]  psHead - Pointer to a node head of the list
+ * @return      Position of the node from 1
+ * @brief       Find the position of a node by walking to the end, going up
+ *              to the top of every tower on the way, in O(log n) on average.
+ *              Only links after the node are followed, so the ones jumping
+ *              over a node being linked or unlinked may be off by one.
+ *****************************************************************************/
+static uint32_t _skip_rank( list_skip_t *psSkip, node_head_t *psHead )
+{
+    uint32_t uiDist = 0;
+    skip_tower_t *psTower;
+    skip_link_t *psLink;
+    while( !(psHead->m_uiFlags & (_NODE_F_ENTRY | _NODE_F_TOWER)) ) {
+        uiDist++;
+        psHead = (void *)psHead->m_psNext;
+    }
+    psTower = (psHead->m_uiFlags & _NODE_F_TOWER)?psSkip->m_ppsTower[_skip_find( psSkip, psHead )]:NULL;
+    while( psTower ) {
+        psLink = &psTower->m_astLink[psTower->m_uiHeight - 2];
+        uiDist += psLink->m_uiWidth;
+        psTower = psLink->m_psNext;
+    }
+    return psSkip->m_uiCount + 1 - uiDist;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_preds
+ * @param [in]  psSkip  - Pointer to a skip list
+ * @param [in]  uiRank  - Position from 1
+ * @param [out] apsPred - Last tower before the position at every level, NULL
+ *                        for the head
+ * @param [out] auiPos  - Position of those towers
+ * @return      None
+ * @brief       Search the levels above the list for the links reaching or
+ *              jumping over a position
+ *****************************************************************************/
+static void _skip_preds( list_skip_t *psSkip, uint32_t uiRank, skip_tower_t **apsPred, uint32_t *auiPos )
+{
+    skip_tower_t *psTower = NULL;
+    uint32_t uiPos = 0;
+    uint32_t uiLevel;
+    skip_link_t *psLink;
+    for( uiLevel = psSkip->m_uiLevel; uiLevel > 0; uiLevel-- ) {
+        psLink = _skip_link( psSkip, psTower, uiLevel );
+        while( psLink->m_psNext && uiPos + psLink->m_uiWidth < uiRank ) {
+            uiPos += psLink->m_uiWidth;
+            psTower = psLink->m_psNext;
+            psLink = _skip_link( psSkip, psTower, uiLevel );
+        }
+        apsPred[uiLevel] = psTower;
+        auiPos[uiLevel] = uiPos;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _skip_insert
+ * @param [in]  psList - Pointer to a list entry with a skip list
+ * @param [in]  psHead - Pointer to a node head just linked into the list
+ * @return      None
+ * @brief       Add a node to the skip list of its list
+ *****************************************************************************/
+static void _skip_insert( list_entry_t *psList, node_head_t *psHead )
+{
+    list_skip_t *psSkip = _CTRL(psList)->m_psSkip;
+    skip_tower_t *apsPred[_SKIP_MAX_LEVEL + 1];
+    uint32_t auiPos[_SKIP_MAX_LEVEL + 1];
+    skip_tower_t *psTower;
+    skip_link_t *psLink;
+    skip_link_t *psOwn;
+    uint32_t uiRank;
+    uint32_t uiHeight;
+    uint32_t i;
+    if( psSkip->m_bStale ) {
+        return;
+    }
+    psSkip->m_uiCount++;
+    uiRank = _skip_rank( psSkip, psHead );
+    psTower = _skip_tower( psSkip, psHead, _skip_height( psSkip ) );
+    uiHeight = psTower?psTower->m_uiHeight:1;
+    for( ; psSkip->m_uiLevel + 1 < uiHeight; psSkip->m_uiLevel++ ) {
+        psSkip->m_astHead[psSkip->m_uiLevel].m_psNext = NULL;
+        psSkip->m_astHead[psSkip->m_uiLevel].m_uiWidth = psSkip->m_uiCount;
+    }
+    _skip_preds( psSkip, uiRank, apsPred, auiPos );
+    for( i = 1; i <= psSkip->m_uiLevel; i++ ) {
+        psLink = _skip_link( psSkip, apsPred[i], i );
+        if( i < uiHeight ) {
+            psOwn = &psTower->m_astLink[i - 1];
+            psOwn->m_psNext = psLink->m_psNext;
+            psOwn->m_uiWidth = auiPos[i] + psLink->m_uiWidth + 1 - uiRank;
+            psLink->m_psNext = psTower;
+            psLink->m_uiWidth = uiRank - auiPos[i];
+        } else {
+            psLink->m_uiWidth++;
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _skip_remove
+ * @param [in]  psList - Pointer to a list entry with a skip list
+ * @param [in]  psHead - Pointer to a node head leaving the list, whose next
+ *                       link still leads back into the list
+ * @return      None
+ * @brief       Remove a node from the skip list of its list
+ *****************************************************************************/
+static void _skip_remove( list_entry_t *psList, node_head_t *psHead )
+{
+    list_skip_t *psSkip = _CTRL(psList)->m_psSkip;
+    skip_tower_t *apsPred[_SKIP_MAX_LEVEL + 1];
+    uint32_t auiPos[_SKIP_MAX_LEVEL + 1];
+    skip_tower_t *psTower;
+    skip_link_t *psLink;
+    skip_link_t *psOwn;
+    uint32_t i;
+    if( !psSkip->m_bStale ) {
+        psTower = (psHead->m_uiFlags & _NODE_F_TOWER)?psSkip->m_ppsTower[_skip_find( psSkip, psHead )]:NULL;
+        _skip_preds( psSkip, _skip_rank( psSkip, psHead ), apsPred, auiPos );
+        for( i = 1; i <= psSkip->m_uiLevel; i++ ) {
+            psLink = _skip_link( psSkip, apsPred[i], i );
+            if( psTower && psLink->m_psNext == psTower ) {
+                psOwn = &psTower->m_astLink[i - 1];
+                psLink->m_psNext = psOwn->m_psNext;
+                psLink->m_uiWidth += psOwn->m_uiWidth - 1;
+            } else {
+                psLink->m_uiWidth--;
+            }
+        }
+        while( psSkip->m_uiLevel && !psSkip->m_astHead[psSkip->m_uiLevel - 1].m_psNext ) {
+            psSkip->m_uiLevel--;
+        }
+        psSkip->m_uiCount--;
+    }
+    _skip_untower( psSkip, psHead );
+}
+
+/**************************************************************************//**
+ * @fn          _skip_clear
+ * @param [in]  psList - Pointer to a list entry with a skip list
+ * @return      None
+ * @brief       Take the towers off all nodes and empty the skip list, keeping
+ *              the tower table for the next nodes
+ *****************************************************************************/
+static void _skip_clear( list_entry_t *psList )
+{
+    list_skip_t *psSkip = _CTRL(psList)->m_psSkip;
+    uint32_t i;
+    for( i = 0; psSkip->m_uiTowers && i <= psSkip->m_uiMask; i++ ) {
+        if( psSkip->m_ppsTower[i] ) {
+            psSkip->m_ppsTower[i]->m_psNode->m_uiFlags &= ~_NODE_F_TOWER;
+            free( psSkip->m_ppsTower[i] );
+            psSkip->m_ppsTower[i] = NULL;
+            psSkip->m_uiTowers--;
+        }
+    }
+    psSkip->m_uiLevel = 0;
+    psSkip->m_uiCount = 0;
+    psSkip->m_bStale = false;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_rebuild
+ * @param [in]  psList - Pointer to a list entry with a skip list
+ * @return      None
+ * @brief       Build the skip list of a list from scratch in one pass
+ *****************************************************************************/
+static void _skip_rebuild( list_entry_t *psList )
+{
+    list_skip_t *psSkip = _CTRL(psList)->m_psSkip;
+    skip_tower_t *apsLast[_SKIP_MAX_LEVEL + 1];
+    uint32_t auiPos[_SKIP_MAX_LEVEL + 1];
+    skip_tower_t *psTower;
+    skip_link_t *psLink;
+    node_head_t *psHead;
+    uint32_t uiPos = 0;
+    uint32_t uiHeight;
+    uint32_t i;
+    _skip_clear( psList );
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        uiPos++;
+        psTower = _skip_tower( psSkip, psHead, _skip_height( psSkip ) );
+        uiHeight = psTower?psTower->m_uiHeight:1;
+        for( i = 1; i < uiHeight; i++ ) {
+            if( i > psSkip->m_uiLevel ) {
+                psSkip->m_uiLevel = i;
+                apsLast[i] = NULL;
+                auiPos[i] = 0;
+            }
+            psLink = _skip_link( psSkip, apsLast[i], i );
+            psLink->m_psNext = psTower;
+            psLink->m_uiWidth = uiPos - auiPos[i];
+            apsLast[i] = psTower;
+            auiPos[i] = uiPos;
+        }
+    }
+    for( i = 1; i <= psSkip->m_uiLevel; i++ ) {
+        psLink = _skip_link( psSkip, apsLast[i], i );
+        psLink->m_psNext = NULL;
+        psLink->m_uiWidth = uiPos + 1 - auiPos[i];
+    }
+    psSkip->m_uiCount = uiPos;
+}
+
+/**************************************************************************//**
+ * @fn          _skip_seek
+ * @param [in]  psList - Pointer to a list entry of a sorted list
+ * @param [in]  pvKey  - Key to look for, passed as the first argument of pfnCmp
+ * @param [in]  pfnCmp - Compare function of a key and a user data field
+ * @param [in]  iMin   - 1 to stop before equal nodes, 0 to pass them
+ * @return      Last node head before the bound, or the entry if none
+ * @brief       Seek a bound in a sorted list, going down the skip list if
+ *              the list has one and walking the list otherwise
+ *****************************************************************************/
+static node_head_t *_skip_seek( list_entry_t *psList, const void *pvKey, list_cmp_t pfnCmp, int iMin )
+{
+    node_head_t *psHead = psList;
+    node_head_t *psNext;
+    skip_tower_t *psTower = NULL;
+    list_skip_t *psSkip;
+    skip_link_t *psLink;
+    uint32_t uiLevel;
+    if( _HAS_SKIP(_OWNER(psList)) ) {
+        psSkip = _CTRL(psList)->m_psSkip;
+        if( psSkip->m_bStale ) {
+            _skip_rebuild( psList );
+        }
+        for( uiLevel = psSkip->m_uiLevel; uiLevel > 0; uiLevel-- ) {
+            psLink = _skip_link( psSkip, psTower, uiLevel );
+            while( psLink->m_psNext && pfnCmp( pvKey, _TO_USER_ADDR(psLink->m_psNext->m_psNode) ) >= iMin ) {
+                psTower = psLink->m_psNext;
+                psLink = _skip_link( psSkip, psTower, uiLevel );
+            }
+        }
+        if( psTower ) {
+            psHead = psTower->m_psNode;
+        }
+    }
+    while( (psNext = (void *)psHead->m_psNext) != psList && pfnCmp( pvKey, _TO_USER_ADDR(psNext) ) >= iMin ) {
+        psHead = psNext;
+    }
+    return psHead;
+}
+
+#ifdef LIST_CFG_STATS
+/**************************************************************************//**
+ * @fn          _stats_link
+ * @param [in]  psOwner - Owner recorded by the node
+ * @param [in]  psHead  - Pointer to a node head which joined the list
+ * @return      None
+ * @brief       Count a node joining a list. Lists are changed by one thread
+ *              at a time, so the peak needs no compare and swap.
+ *****************************************************************************/
+static inline void _stats_link( list_entry_t *psOwner, node_head_t *psHead )
+{
+    list_stats_t *psStats;
+    uint64_t ulLength;
+    uint32_t uiBucket;
+    if( !_HAS_STATS(psOwner) ) {
+        return;
+    }
+    psStats = &_REC(psOwner)->m_stStats;
+    uiBucket = (psHead->m_uiSize <= 8)?0:(32 - __builtin_clz( psHead->m_uiSize - 1 ) - 3);
+    uiBucket = (uiBucket < LIST_STATS_BUCKETS)?uiBucket:(LIST_STATS_BUCKETS - 1);
+    ulLength = __atomic_add_fetch( &psStats->m_ulInserts, 1, __ATOMIC_RELAXED )
+               - __atomic_load_n( &psStats->m_ulDeletes, __ATOMIC_RELAXED );
+    __atomic_fetch_add( &psStats->m_ulBytesIn, _HEAD_SIZE + psHead->m_uiSize, __ATOMIC_RELAXED );
+    __atomic_fetch_add( &psStats->m_aulSizeHist[uiBucket], 1, __ATOMIC_RELAXED );
+    if( ulLength > __atomic_load_n( &psStats->m_ulPeak, __ATOMIC_RELAXED ) ) {
+        __atomic_store_n( &psStats->m_ulPeak, ulLength, __ATOMIC_RELAXED );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _stats_unlink
+ * @param [in]  psOwner - Owner recorded by the node
+ * @param [in]  psHead  - Pointer to a node head leaving the list
+ * @return      None
+ * @brief       Count a node leaving a list
+ *****************************************************************************/
+static inline void _stats_unlink( list_entry_t *psOwner, node_head_t *psHead )
+{
+    _STATS_ADD(psOwner, m_ulDeletes, 1);
+    _STATS_ADD(psOwner, m_ulBytesOut, _HEAD_SIZE + psHead->m_uiSize);
+}
+
+/**************************************************************************//**
+ * @fn          _stats_resize
+ * @param [in]  psOwner - Owner recorded by the node, NULL for an idle node
+ * @param [in]  uiOld   - Old size of user data field
+ * @param [in]  uiNew   - New size of user data field
+ * @return      None
+ * @brief       Account for a node of a list changing its size
+ *****************************************************************************/
+static inline void _stats_resize( list_entry_t *psOwner, uint32_t uiOld, uint32_t uiNew )
+{
+    if( !psOwner ) {
+        return;
+    }
+    if( uiNew > uiOld ) {
+        _STATS_ADD(psOwner, m_ulBytesIn, uiNew - uiOld);
+    } else {
+        _STATS_ADD(psOwner, m_ulBytesOut, uiOld - uiNew);
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _stats_flush
+ * @param [in]  psList - Pointer to a list entry about to be flushed
+ * @return      None
+ * @brief       Count all nodes of a list leaving at once, without a walk
+ *****************************************************************************/
+static void _stats_flush( list_entry_t *psList )
+{
+    list_stats_t *psStats;
+    if( !_HAS_STATS(psList) ) {
+        return;
+    }
+    psStats = &_REC(psList)->m_stStats;
+    __atomic_store_n( &psStats->m_ulDeletes,
+                      __atomic_load_n( &psStats->m_ulInserts, __ATOMIC_RELAXED ), __ATOMIC_RELAXED );
+    __atomic_store_n( &psStats->m_ulBytesOut,
+                      __atomic_load_n( &psStats->m_ulBytesIn, __ATOMIC_RELAXED ), __ATOMIC_RELAXED );
+}
+
+/**************************************************************************//**
+ * @fn          _stats_register
+ * @param [in]  psList - Pointer to a new list entry with room for a record
+ * @return      None
+ * @brief       Start counting a list and add it to the registry. Lists
+ *              created with LIST_OPT_NO_OWNER are not counted, their nodes
+ *              do not know which list they leave.
+ *****************************************************************************/
+static void _stats_register( list_entry_t *psList )
+{
+    stats_rec_t *psRec = _REC(psList);
+    if( psList->m_uiFlags & _LIST_F_NO_OWNER ) {
+        return;
+    }
+    psList->m_uiFlags |= _LIST_F_STATS;
+    pthread_mutex_lock( &s_sStatsLock );
+    psRec->m_psNext = &s_stStatsReg;
+    psRec->m_psPrev = s_stStatsReg.m_psPrev;
+    s_stStatsReg.m_psPrev->m_psNext = psRec;
+    s_stStatsReg.m_psPrev = psRec;
+    pthread_mutex_unlock( &s_sStatsLock );
+}
+
+/**************************************************************************//**
+ * @fn          _stats_unregister
+ * @param [in]  psList - Pointer to a list entry about to be freed
+ * @return      None
+ * @brief       Take a list out of the registry
+ *****************************************************************************/
+static void _stats_unregister( list_entry_t *psList )
+{
+    stats_rec_t *psRec = _REC(psList);
+    if( !_HAS_STATS(psList) ) {
+        return;
+    }
+    pthread_mutex_lock( &s_sStatsLock );
+    psRec->m_psPrev->m_psNext = psRec->m_psNext;
+    psRec->m_psNext->m_psPrev = psRec->m_psPrev;
+    pthread_mutex_unlock( &s_sStatsLock );
+}
+
+/**************************************************************************//**
+ * @fn          _stats_entry
+ * @param [in]  psRec - Pointer to a record in the registry
+ * @return      Pointer to the list entry owning the record
+ * @brief       Get the list of a record
+ *****************************************************************************/
+static inline list_entry_t *_stats_entry( stats_rec_t *psRec )
+{
+    return (list_entry_t *)((uint8_t *)psRec - offsetof( list_stctrl_t, m_stRec ));
+}
+
+#endif
+
+/**************************************************************************//**
+ * @fn          _hook_link
+ * @param [in]  psOwner - Owner recorded by the node
+ * @param [in]  psHead  - Pointer to a node head which joined the list
+ * @return      None
+ * @brief       Keep the overlays of a list up to date with a new node
+ *****************************************************************************/
+static inline void _hook_link( list_entry_t *psOwner, node_head_t *psHead )
+{
+    _stats_link( psOwner, psHead );
+    if( _HAS_HOOK(psOwner) ) {
+        if( _CTRL(psOwner)->m_psIndex ) {
+            _index_insert( _CTRL(psOwner)->m_psIndex, psHead );
+        }
+        if( _CTRL(psOwner)->m_psSkip ) {
+            _skip_insert( psOwner, psHead );
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _hook_unlink
+ * @param [in]  psOwner - Owner recorded by the node
+ * @param [in]  psHead  - Pointer to a node head leaving the list
+ * @return      None
+ * @brief       Keep the overlays of a list up to date with a leaving node
+ *****************************************************************************/
+static inline void _hook_unlink( list_entry_t *psOwner, node_head_t *psHead )
+{
+    _stats_unlink( psOwner, psHead );
+    if( _HAS_HOOK(psOwner) ) {
+        if( _CTRL(psOwner)->m_psIndex ) {
+            _index_remove( _CTRL(psOwner)->m_psIndex, psHead );
+        }
+        if( _CTRL(psOwner)->m_psSkip ) {
+            _skip_remove( psOwner, psHead );
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _hook_reorder
+ * @param [in]  psOwner - Owner of nodes being moved around in bulk
+ * @return      None
+ * @brief       Tell the overlays of a list that its order is about to change
+ *              in a way too large to follow node by node
+ *****************************************************************************/
+static inline void _hook_reorder( list_entry_t *psOwner )
+{
+    if( _HAS_SKIP(psOwner) ) {
+        _CTRL(psOwner)->m_psSkip->m_bStale = true;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _hook_move
+ * @param [in]  psOwner - Owner recorded by the node
+ * @param [in]  psOld   - Pointer to the node head before the move
+ * @param [in]  psNew   - Pointer to the copy which took its place
+ * @return      None
+ * @brief       Tell the overlays of a list that a node moved in memory
+ *****************************************************************************/
+static inline void _hook_move( list_entry_t *psOwner, node_head_t *psOld, node_head_t *psNew )
+{
+    if( _HAS_HOOK(psOwner) ) {
+        if( _CTRL(psOwner)->m_psIndex ) {
+            _index_move( _CTRL(psOwner)->m_psIndex, psOld, psNew );
+        }
+        if( _CTRL(psOwner)->m_psSkip ) {
+            /* Other towers still lead to the old address, the skip list is
+             * rebuilt on next use anyway */
+            _skip_untower( _CTRL(psOwner)->m_psSkip, psOld );
+            psNew->m_uiFlags &= ~_NODE_F_TOWER;
+        }
+        _hook_reorder( psOwner );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _node_release
+ * @param [in]  psHead - Pointer to a node head
+ * @return      None
+ * @brief       Give the memory of a node back to where it was taken from
+ *****************************************************************************/
+static void _node_release( node_head_t *psHead )
+{
+    list_pool_t *psPool = _NODE_POOL(psHead);
+    if( _IS_EXTERN(psHead) ) {
+        psHead->m_psList = NULL;
+    } else if( psPool && psPool->m_uiKind == _POOL_CACHE ) {
+        _cache_free( psHead );
+    } else if( psPool && psPool->m_uiKind == _POOL_BLOCK ) {
+        if( !--psPool->m_uiChunkNodes ) {
+            free( psPool );
+        }
+    } else if( psPool ) {
+        psHead->m_psNext = (void *)psPool->m_psFree;
+        psPool->m_psFree = psHead;
+    } else {
+        free( psHead );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _node_replace
+ * @param [in]  psOld - Pointer to a used node head
+ * @param [in]  psNew - Pointer to an idle node head
+ * @return      None
+ * @brief       Put an idle node at the position of a used one. The used node
+ *              becomes idle and the length of the list does not change.
+ *****************************************************************************/
+static void _node_replace( node_head_t *psOld, node_head_t *psNew )
+{
+    psNew->m_psList = psOld->m_psList;
+    psNew->m_psNext = psOld->m_psNext;
+    psNew->m_psPrev = psOld->m_psPrev;
+    psNew->m_psNext->m_stHead.m_psPrev = (void *)psNew;
+    psNew->m_psPrev->m_stHead.m_psNext = (void *)psNew;
+    psOld->m_psList = NULL;
+}
+
+/**************************************************************************//**
+ * @fn          _node_put_after
+ * @param [in]  psPos  - Pointer to a used node head or a list entry
+ * @param [in]  pvNode - Pointer to an idle node
+ * @return      None
+ * @brief       Link a node after a node or at the front of a list
+ *****************************************************************************/
+static void _node_put_after( node_head_t *psPos, void *pvNode )
+{
+    if( psPos->m_uiFlags & _NODE_F_ENTRY ) {
+        list_add_front( _TO_USER_ADDR(psPos), pvNode );
+    } else {
+        ilst_insert_after( _TO_USER_ADDR(psPos), pvNode );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _chain_move
+ * @param [in]  psPos   - Node or entry to put the chain before
+ * @param [in]  psFirst - First node of a chain in a list
+ * @param [in]  psLast  - Last node of the chain
+ * @return      None
+ * @brief       Cut a chain out of its ring and link it before a position,
+ *              touching the two ends only
+ *****************************************************************************/
+static void _chain_move( node_head_t *psPos, node_head_t *psFirst, node_head_t *psLast )
+{
+    psFirst->m_psPrev->m_stHead.m_psNext = psLast->m_psNext;
+    psLast->m_psNext->m_stHead.m_psPrev = psFirst->m_psPrev;
+    psFirst->m_psPrev = psPos->m_psPrev;
+    psLast->m_psNext = (void *)psPos;
+    psPos->m_psPrev->m_stHead.m_psNext = (void *)psFirst;
+    psPos->m_psPrev = (void *)psLast;
+}
+
+/**************************************************************************//**
+ * @fn          _chain_adopt
+ * @param [in]  psFirst - First node of a chain
+ * @param [in]  psLast  - Last node of the chain
+ * @param [in]  psOwner - Owner to record in every node of the chain
+ * @return      Number of nodes in the chain
+ * @brief       Record a new owner in the nodes of a chain and move them
+ *              between the overlays of the old and the new owner
+ *****************************************************************************/
+static uint32_t _chain_adopt( node_head_t *psFirst, node_head_t *psLast, list_entry_t *psOwner )
+{
+    uint32_t uiCount = 1;
+    for( ; psFirst != psLast; psFirst = (void *)psFirst->m_psNext ) {
+        _hook_unlink( psFirst->m_psList, psFirst );
+        psFirst->m_psList = psOwner;
+        _hook_link( psOwner, psFirst );
+        uiCount++;
+    }
+    _hook_unlink( psLast->m_psList, psLast );
+    psLast->m_psList = psOwner;
+    _hook_link( psOwner, psLast );
+    return uiCount;
+}
+
+/**************************************************************************//**
+ * @fn          _sort_merge
+ * @param [in]  psA    - Chain of sorted nodes
+ * @param [in]  psB    - Chain of sorted nodes following the former ones
+ * @param [in]  pfnCmp - Compare function on user data fields
+ * @return      Merged chain
+ * @brief       Merge two NULL terminated chains linked by m_psNext only. On
+ *              equal nodes the one of psA goes first to keep the sort stable.
+ *****************************************************************************/
+static node_head_t *_sort_merge( node_head_t *psA, node_head_t *psB, list_cmp_t pfnCmp )
+{
+    node_head_t sHead;
+    node_head_t *psTail = &sHead;
+    while( psA && psB ) {
+        if( pfnCmp( _TO_USER_ADDR(psA), _TO_USER_ADDR(psB) ) <= 0 ) {
+            psTail->m_psNext = (void *)psA;
+            psA = (void *)psA->m_psNext;
+        } else {
+            psTail->m_psNext = (void *)psB;
+            psB = (void *)psB->m_psNext;
+        }
+        psTail = (void *)psTail->m_psNext;
+    }
+    psTail->m_psNext = (void *)(psA?psA:psB);
+    return (void *)sHead.m_psNext;
+}
+
+/**************************************************************************//**
+ * @fn          _sort_chain
+ * @param [in]  psChain - NULL terminated chain linked by m_psNext only
+ * @param [in]  pfnCmp  - Compare function on user data fields
+ * @return      Sorted chain
+ * @brief       Bottom-up merge sort. Slot i holds a pending sorted run of 2^i
+ *              nodes, older runs in higher slots, like a binary counter.
+ *****************************************************************************/
+static node_head_t *_sort_chain( node_head_t *psChain, list_cmp_t pfnCmp )
+{
+    node_head_t *apsSlot[_SORT_SLOTS] = { NULL };
+    node_head_t *psCarry;
+    node_head_t *psResult = NULL;
+    uint32_t i;
+    while( psChain ) {
+        psCarry = psChain;
+        psChain = (void *)psChain->m_psNext;
+        psCarry->m_psNext = NULL;
+        for( i = 0; i < _SORT_SLOTS - 1 && apsSlot[i]; i++ ) {
+            psCarry = _sort_merge( apsSlot[i], psCarry, pfnCmp );
+            apsSlot[i] = NULL;
+        }
+        apsSlot[i] = (i == _SORT_SLOTS - 1 && apsSlot[i])?
+                     _sort_merge( apsSlot[i], psCarry, pfnCmp ):psCarry;
+    }
+    for( i = 0; i < _SORT_SLOTS; i++ ) {
+        if( apsSlot[i] ) {
+            psResult = psResult?_sort_merge( apsSlot[i], psResult, pfnCmp ):apsSlot[i];
+        }
+    }
+    return psResult;
+}
+
+/**************************************************************************//**
+ * @fn          _sort_worker
+ * @param [in]  pvJob - Pointer to a sort job
+ * @return      NULL
+ * @brief       Thread entry sorting or merging the chains of a job
+ *****************************************************************************/
+static void *_sort_worker( void *pvJob )
+{
+    sort_job_t *psJob = pvJob;
+    if( psJob->m_psOther ) {
+        psJob->m_psChain = _sort_merge( psJob->m_psChain, psJob->m_psOther, psJob->m_pfnCmp );
+        psJob->m_psOther = NULL;
+    } else {
+        psJob->m_psChain = _sort_chain( psJob->m_psChain, psJob->m_pfnCmp );
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          _sort_run_jobs
+ * @param [in]  psJobs - Array of jobs
+ * @param [in]  uiJobs - Number of jobs
+ * @return      None
+ * @brief       Run jobs on worker threads. A job whose thread can not be
+ *              started runs on the calling thread instead.
+ *****************************************************************************/
+static void _sort_run_jobs( sort_job_t *psJobs, uint32_t uiJobs )
+{
+    pthread_t asThread[_SORT_MAX_THREADS];
+    bool abStarted[_SORT_MAX_THREADS];
+    uint32_t i;
+    for( i = 1; i < uiJobs; i++ ) {
+        abStarted[i] = !pthread_create( &asThread[i], NULL, _sort_worker, &psJobs[i] );
+    }
+    _sort_worker( &psJobs[0] );
+    for( i = 1; i < uiJobs; i++ ) {
+        if( abStarted[i] ) {
+            pthread_join( asThread[i], NULL );
+        } else {
+            _sort_worker( &psJobs[i] );
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _sort_relink
+ * @param [in]  psList  - Pointer to a list entry
+ * @param [in]  psChain - Sorted chain of all nodes of the list
+ * @return      None
+ * @brief       Close a sorted chain into the ring of a list and restore the
+ *              m_psPrev links
+ *****************************************************************************/
+static void _sort_relink( list_entry_t *psList, node_head_t *psChain )
+{
+    node_head_t *psPrev = psList;
+    while( psChain ) {
+        psChain->m_psPrev = (void *)psPrev;
+        psPrev->m_psNext = (void *)psChain;
+        psPrev = psChain;
+        psChain = (void *)psChain->m_psNext;
+    }
+    psPrev->m_psNext = (void *)psList;
+    psList->m_psPrev = (void *)psPrev;
+}
+
+/**************************************************************************//**
+ * @fn          _compact_run
+ * @param [in]  psList      - Pointer to a list entry
+ * @param [in]  psFrom      - Node head to start from
+ * @param [in]  uiNodes     - Maximum number of nodes to pass
+ * @param [in]  pfnRelocate - Relocation callback or NULL
+ * @return      Node head to go on from, the entry at the end, or NULL if out
+ *              of memory
+ * @brief       Copy a run of nodes into one new block in list order. Each
+ *              node is relinked in place of the old one, which is reported
+ *              and then released. Embedded links can not move and are left
+ *              where they are. A block is freed with its last node.
+ *****************************************************************************/
+static node_head_t *_compact_run( list_entry_t *psList, node_head_t *psFrom, uint32_t uiNodes,
+                                  list_relocate_t pfnRelocate )
+{
+    list_pool_t *psBlock;
+    node_head_t *psHead;
+    node_head_t *psNext;
+    node_head_t *psNew;
+    size_t ulSize = 0;
+    uint32_t uiCount = 0;
+    uint32_t i;
+    for( psHead = psFrom, i = 0; psHead != psList && i < uiNodes; psHead = (void *)psHead->m_psNext, i++ ) {
+        if( _CAN_MOVE(psHead) ) {
+            ulSize += _POOL_STRIDE(psHead->m_uiSize);
+            uiCount++;
+        }
+    }
+    if( !uiCount ) {
+        return psHead;
+    }
+    psBlock = malloc( _BLOCK_HEAD_SIZE + ulSize );
+    if( !psBlock ) {
+        return NULL;
+    }
+    memset( psBlock, 0, sizeof( list_pool_t ) );
+    psBlock->m_uiChunkNodes = uiCount;
+    psBlock->m_uiKind = _POOL_BLOCK;
+    psNew = (void *)psBlock + _BLOCK_HEAD_SIZE;
+    for( psHead = psFrom, i = 0; psHead != psList && i < uiNodes; psHead = psNext, i++ ) {
+        psNext = (void *)psHead->m_psNext;
+        if( !_CAN_MOVE(psHead) ) {
+            continue;
+        }
+        memcpy( psNew, psHead, _HEAD_SIZE + psHead->m_uiSize );
+        _SET_POOL(psNew, psBlock);
+        psNew->m_uiFlags |= _NODE_F_POOLED;
+        psNew->m_psPrev->m_stHead.m_psNext = (void *)psNew;
+        psNew->m_psNext->m_stHead.m_psPrev = (void *)psNew;
+        _hook_move( psNew->m_psList, psHead, psNew );
+        if( pfnRelocate ) {
+            pfnRelocate( _TO_USER_ADDR(psHead), _TO_USER_ADDR(psNew) );
+        }
+        _node_release( psHead );
+        psNew = (void *)psNew + _POOL_STRIDE(psNew->m_uiSize);
+    }
+    return psHead;
+}
+
+/**************************************************************************//**
+ * @fn          _save_flush
+ * @param [in]  psBuf - Pointer to a save buffer
+ * @return      None
+ * @brief       Write out the buffered bytes, retrying short writes
+ *****************************************************************************/
+static void _save_flush( save_buf_t *psBuf )
+{
+    uint32_t uiDone = 0;
+    ssize_t lRet;
+    while( psBuf->m_bOk && uiDone < psBuf->m_uiUsed ) {
+        lRet = write( psBuf->m_iFd, psBuf->m_pBuf + uiDone, psBuf->m_uiUsed - uiDone );
+        if( lRet > 0 ) {
+            uiDone += lRet;
+        } else if( lRet < 0 && errno != EINTR ) {
+            psBuf->m_bOk = false;
+        }
+    }
+    psBuf->m_uiUsed = 0;
+}
+
+/**************************************************************************//**
+ * @fn          _save_put
+ * @param [in]  psBuf  - Pointer to a save buffer
+ * @param [in]  pvData - Bytes to write, NULL for zeros
+ * @param [in]  uiSize - Number of bytes
+ * @return      None
+ * @brief       Append bytes to a save buffer
+ *****************************************************************************/
+static void _save_put( save_buf_t *psBuf, const void *pvData, uint32_t uiSize )
+{
+    uint32_t uiPart;
+    while( uiSize ) {
+        if( psBuf->m_uiUsed == _SAVE_BUF_SIZE ) {
+            _save_flush( psBuf );
+        }
+        uiPart = _SAVE_BUF_SIZE - psBuf->m_uiUsed;
+        uiPart = (uiPart < uiSize)?uiPart:uiSize;
+        if( pvData ) {
+            memcpy( psBuf->m_pBuf + psBuf->m_uiUsed, pvData, uiPart );
+            pvData += uiPart;
+        } else {
+            memset( psBuf->m_pBuf + psBuf->m_uiUsed, 0, uiPart );
+        }
+        psBuf->m_uiUsed += uiPart;
+        uiSize -= uiPart;
+    }
+}
+
+#ifdef LIST_CFG_STATS
+/**************************************************************************//**
+ * @fn          _stats_emit
+ * @param [in]  psBuf - Pointer to a save buffer
+ * @param [in]  psRec - Pointer to a record in the registry
+ * @param [in]  bNext - true if a record was emitted before
+ * @return      None
+ * @brief       Append the JSON object of a list to a save buffer
+ *****************************************************************************/
+static void _stats_emit( save_buf_t *psBuf, stats_rec_t *psRec, bool bNext )
+{
+    list_stats_t sStats;
+    char acLine[_STATS_LINE_SIZE];
+    uint64_t ulLength;
+    bool bBucket = false;
+    uint32_t i;
+    int iLen;
+    list_stats_get( _TO_USER_ADDR(_stats_entry( psRec )), &sStats );
+    ulLength = sStats.m_ulInserts - sStats.m_ulDeletes;
+    iLen = snprintf( acLine, sizeof( acLine ),
+                     "%s\n{\"list\":\"%p\",\"name\":\"%s\",\"length\":%llu,\"peak\":%llu,"
+                     "\"inserts\":%llu,\"deletes\":%llu,\"next\":%llu,\"prev\":%llu,",
+                     bNext?",":"", _TO_USER_ADDR(_stats_entry( psRec )), psRec->m_acName,
+                     (unsigned long long)ulLength, (unsigned long long)sStats.m_ulPeak,
+                     (unsigned long long)sStats.m_ulInserts, (unsigned long long)sStats.m_ulDeletes,
+                     (unsigned long long)sStats.m_ulNext, (unsigned long long)sStats.m_ulPrev );
+    _save_put( psBuf, acLine, iLen );
+    iLen = snprintf( acLine, sizeof( acLine ),
+                     "\"bytes_in\":%llu,\"bytes_out\":%llu,\"live_bytes\":%llu,\"head_bytes\":%llu,"
+                     "\"size_hist\":{",
+                     (unsigned long long)sStats.m_ulBytesIn, (unsigned long long)sStats.m_ulBytesOut,
+                     (unsigned long long)(sStats.m_ulBytesIn - sStats.m_ulBytesOut),
+                     (unsigned long long)(ulLength * _HEAD_SIZE) );
+    _save_put( psBuf, acLine, iLen );
+    for( i = 0; i < LIST_STATS_BUCKETS; i++ ) {
+        if( !sStats.m_aulSizeHist[i] ) {
+            continue;
+        }
+        if( i < LIST_STATS_BUCKETS - 1 ) {
+            iLen = snprintf( acLine, sizeof( acLine ), "%s\"%u\":%llu", bBucket?",":"",
+                             8u << i, (unsigned long long)sStats.m_aulSizeHist[i] );
+        } else {
+            iLen = snprintf( acLine, sizeof( acLine ), "%s\"more\":%llu", bBucket?",":"",
+                             (unsigned long long)sStats.m_aulSizeHist[i] );
+        }
+        _save_put( psBuf, acLine, iLen );
+        bBucket = true;
+    }
+    _save_put( psBuf, "}}", 2 );
+}
+#endif
+
+/**************************************************************************//**
+ * @fn          _map_base
+ * @param [in]  ulSize - Size of the image
+ * @return      Preferred address for a new image or 0 for none
+ * @brief       Pick an address the saving process could map the image at.
+ *              The address space layout differs from process to process,
+ *              so it is likely free in the one mapping the image as well.
+ *****************************************************************************/
+static uint64_t _map_base( uint64_t ulSize )
+{
+    void *pvAddr = mmap( NULL, ulSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if( pvAddr == MAP_FAILED ) {
+        return 0;
+    }
+    munmap( pvAddr, ulSize );
+    return (uintptr_t)pvAddr;
+}
+
+/**************************************************************************//**
+ * @fn          _map_fix
+ * @param [in]  ppvLink - Pointer to a link in a mapped image
+ * @param [in]  ulOff   - Offset the link must point to
+ * @param [in]  psHead  - Head of the image
+ * @param [in]  pvMap   - Address the image is mapped at
+ * @return      true if right, false if the link points elsewhere
+ * @brief       Check a link against the layout of an image and move it from
+ *              the preferred address to the actual one if they differ
+ *****************************************************************************/
+static bool _map_fix( void **ppvLink, uint64_t ulOff, const map_head_t *psHead, void *pvMap )
+{
+    if( (uint64_t)(uintptr_t)*ppvLink != psHead->m_ulBase + ulOff ) {
+        return false;
+    }
+    if( (uintptr_t)pvMap != psHead->m_ulBase ) {
+        *ppvLink = pvMap + ulOff;
+    }
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          _map_relocate
+ * @param [in]  pvMap  - Mapping of an image, writable unless it is at the
+ *                       preferred address
+ * @param [in]  psHead - Head of the image
+ * @return      true if sound, false if the image is corrupted
+ * @brief       Check every link and flag of an image in one pass over the
+ *              nodes laid out in list order, fixing up the links if it is
+ *              mapped away from its preferred address. A link must point
+ *              exactly where list_save put its target.
+ *****************************************************************************/
+static bool _map_relocate( void *pvMap, const map_head_t *psHead )
+{
+    list_ctrl_t *psCtrl = pvMap + _MAP_ENTRY_OFF;
+    list_entry_t *psList = &psCtrl->m_stEntry;
+    node_head_t *psNode;
+    uint64_t ulPrev = _MAP_ENTRY_OFF;
+    uint64_t ulOff = _MAP_NODE_OFF;
+    uint64_t ulNext;
+    uint32_t i;
+    if( psList->m_uiFlags != (_NODE_F_ENTRY | _NODE_F_MAPPED)
+        || psCtrl->m_psPool || psCtrl->m_psIndex || psCtrl->m_psSkip
+        || !_map_fix( (void **)&psList->m_psNext, psList->m_uiSize?_MAP_NODE_OFF:_MAP_ENTRY_OFF, psHead, pvMap )
+        || !_map_fix( (void **)&psList->m_psList, _MAP_ENTRY_OFF, psHead, pvMap ) ) {
+        return false;
+    }
+    for( i = 0; i < psList->m_uiSize; i++ ) {
+        psNode = pvMap + ulOff;
+        if( ulOff + _HEAD_SIZE > psHead->m_ulSize
+            || ulOff + _NODE_STRIDE((uint64_t)psNode->m_uiSize) > psHead->m_ulSize ) {
+            return false;
+        }
+        ulNext = ulOff + _NODE_STRIDE((uint64_t)psNode->m_uiSize);
+        if( psNode->m_uiFlags != _NODE_F_MAPPED
+            || !_map_fix( (void **)&psNode->m_psNext, (i + 1 < psList->m_uiSize)?ulNext:_MAP_ENTRY_OFF,
+                          psHead, pvMap )
+            || !_map_fix( (void **)&psNode->m_psPrev, ulPrev, psHead, pvMap )
+            || !_map_fix( (void **)&psNode->m_psList, _MAP_ENTRY_OFF, psHead, pvMap ) ) {
+            return false;
+        }
+        ulPrev = ulOff;
+        ulOff = ulNext;
+    }
+    return ulOff == psHead->m_ulSize
+           && _map_fix( (void **)&psList->m_psPrev, ulPrev, psHead, pvMap );
+}
+
+/**************************************************************************//**
+ * @fn          _map_release
+ * @param [in]  psList - Pointer to the entry of a mapped list
+ * @return      None
+ * @brief       Unmap the image of a mapped list
+ *****************************************************************************/
+static void _map_release( list_entry_t *psList )
+{
+    map_head_t *psHead = (void *)psList - _MAP_ENTRY_OFF;
+    munmap( psHead, psHead->m_ulSize );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          list_create
+ * @param       None
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list
+ *****************************************************************************/
+void *list_create( void )
+{
+    return list_create_ex( NULL, 0 );
+}
+
+/**************************************************************************//**
+ * @fn          list_create_from
+ * @param [in]  pvPool - Pool handle
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list backed by a node pool. Only nodes
+ *              carved from this pool can be added to the list, which lets
+ *              list_flush and list_destroy release all nodes in one step.
+ *****************************************************************************/
+void *list_create_from( void *pvPool )
+{
+    return pvPool?list_create_ex( pvPool, 0 ):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_create_ex
+ * @param [in]  pvPool    - Pool handle or NULL for a list not backed by a pool
+ * @param [in]  uiOptions - LIST_OPT_xxx flags
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list with options. A list with
+ *              LIST_OPT_NO_OWNER can not be backed by a pool.
+ *****************************************************************************/
+void *list_create_ex( void *pvPool, uint32_t uiOptions )
+{
+    list_entry_t *psList;
+    if( pvPool && (uiOptions & LIST_OPT_NO_OWNER) ) {
+        return NULL;
+    }
+    psList = calloc( 1, _CTRL_SIZE );
+    if( psList ) {
+        psList->m_psNext =  (void *)psList;
+        psList->m_psPrev =  (void *)psList;
+        psList->m_psList =  (void *)psList;
+        _LIST_POOL(psList) = pvPool;
+        psList->m_uiSize = 0;
+        psList->m_uiFlags = _NODE_F_ENTRY;
+        if( uiOptions & LIST_OPT_NO_OWNER ) {
+            psList->m_uiFlags |= _LIST_F_NO_OWNER;
+        }
+        _stats_register( psList );
+    }
+    return psList?_TO_USER_ADDR(psList):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_pool_create
+ * @param [in]  uiNodeSize   - Size of user data field of every node
+ * @param [in]  uiChunkNodes - Number of nodes carved from one chunk
+ * @return      Handle of the created pool or NULL if failed
+ * @brief       Create a node pool. Nodes are carved from large chunks and
+ *              recycled through a free list instead of malloc and free.
+ *****************************************************************************/
+void *list_pool_create( uint32_t uiNodeSize, uint32_t uiChunkNodes )
+{
+    list_pool_t *psPool;
+    if( !uiChunkNodes ) {
+        return NULL;
+    }
+    psPool = malloc( sizeof( list_pool_t ) );
+    if( psPool ) {
+        psPool->m_psFree = NULL;
+        psPool->m_pvChunks = NULL;
+        psPool->m_uiNodeSize = uiNodeSize;
+        psPool->m_uiChunkNodes = uiChunkNodes;
+        psPool->m_uiKind = _POOL_CHUNK;
+    }
+    return psPool;
+}
+
+/**************************************************************************//**
+ * @fn          list_pool_destroy
+ * @param [in]  pvPool - Pool handle
+ * @return      None
+ * @brief       Free a pool including all chunks. Every node carved from the
+ *              pool becomes invalid, so no list may still hold one of them.
+ *****************************************************************************/
+void list_pool_destroy( void *pvPool )
+{
+    list_pool_t *psPool = pvPool;
+    void *pvChunk;
+    if( psPool ) {
+        while( psPool->m_pvChunks ) {
+            pvChunk = psPool->m_pvChunks;
+            psPool->m_pvChunks = *(void **)pvChunk;
+            free( pvChunk );
+        }
+        free( psPool );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_node_alloc_from
+ * @param [in]  pvPool - Pool handle
+ * @return      Pointer to the created node or NULL if failed
+ * @brief       Take a node from a pool. The size of user data field is the
+ *              node size given when the pool was created.
+ *****************************************************************************/
+void *list_node_alloc_from( void *pvPool )
+{
+    list_pool_t *psPool = pvPool;
+    node_head_t *psHead;
+    if( !psPool || (!psPool->m_psFree && !_pool_grow( psPool, psPool->m_uiChunkNodes, 0 )) ) {
+        return NULL;
+    }
+    psHead = psPool->m_psFree;
+    psPool->m_psFree = (void *)psHead->m_psNext;
+    psHead->m_uiSize = psPool->m_uiNodeSize;
+    psHead->m_psList = NULL;
+    return _TO_USER_ADDR(psHead);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_alloc
+ * @param [in]  uiSize - Expected size of user data field
+ * @return      Pointer to the created node or NULL if failed
+ * @brief       Create a new element node with specified size of user data field
+ *****************************************************************************/
+void *list_node_alloc( uint32_t uiSize )
+{
+    list_node_t *psNode = NULL;
+    uint32_t uiClass;
+    if( __atomic_load_n( &s_bCacheOn, __ATOMIC_RELAXED )
+        && (uiClass = _cache_class( uiSize )) < _CACHE_CLASSES ) {
+        psNode = (void *)_cache_alloc( uiClass );
+    }
+    if( !psNode ) {
+        psNode = malloc( _HEAD_SIZE + uiSize );
+        if( psNode ) {
+            psNode->m_stHead.m_uiFlags = 0;
+        }
+    }
+    if( psNode ) {
+        psNode->m_stHead.m_uiSize  = uiSize;
+        psNode->m_stHead.m_psList = NULL;
+        psNode->m_stHead.m_uiFlags &= _NODE_F_POOLED;
+        return (void *)psNode->m_pData;
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_alloc_batch
+ * @param [in]  uiSize   - Expected size of user data field of every node
+ * @param [in]  uiNodes  - Number of nodes
+ * @param [out] ppvNodes - Array receiving the created nodes
+ * @return      true if created, false if failed
+ * @brief       Create a number of nodes out of one allocation. The nodes are
+ *              laid out in array order and are freed one by one as usual,
+ *              the memory goes back with the last of them.
+ *****************************************************************************/
+bool list_alloc_batch( uint32_t uiSize, uint32_t uiNodes, void **ppvNodes )
+{
+    list_pool_t *psBlock;
+    node_head_t *psHead;
+    size_t ulStride = _POOL_STRIDE((size_t)uiSize);
+    uint32_t i;
+    if( !uiNodes || !ppvNodes || ulStride > (SIZE_MAX - _BLOCK_HEAD_SIZE) / uiNodes ) {
+        return false;
+    }
+    psBlock = malloc( _BLOCK_HEAD_SIZE + ulStride * uiNodes );
+    if( !psBlock ) {
+        return false;
+    }
+    memset( psBlock, 0, sizeof( list_pool_t ) );
+    psBlock->m_uiChunkNodes = uiNodes;
+    psBlock->m_uiKind = _POOL_BLOCK;
+    psHead = (void *)psBlock + _BLOCK_HEAD_SIZE;
+    for( i = 0; i < uiNodes; i++ ) {
+        psHead->m_psList = NULL;
+        _SET_POOL(psHead, psBlock);
+        psHead->m_uiSize = uiSize;
+        psHead->m_uiFlags = _NODE_F_POOLED;
+        ppvNodes[i] = _TO_USER_ADDR(psHead);
+        psHead = (void *)psHead + ulStride;
+    }
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          list_node_cache_enable
+ * @param [in]  bEnable - true to serve list_node_alloc from the node cache
+ * @return      None
+ * @brief       Switch the node cache of list_node_alloc on or off. With the
+ *              cache on, nodes up to 4 KB are rounded up to a power of two
+ *              size class and recycled through per-thread magazines, which
+ *              are traded in batches with a shared depot of bounded size.
+ *              A node always goes back to where it came from, so the switch
+ *              may be flipped at any time.
+ *****************************************************************************/
+void list_node_cache_enable( bool bEnable )
+{
+    if( bEnable ) {
+        pthread_once( &s_sCacheOnce, _cache_init );
+    }
+    __atomic_store_n( &s_bCacheOn, bEnable, __ATOMIC_RELEASE );
+}
+
+/**************************************************************************//**
+ * @fn          list_link_init
+ * @param [in]  psLink - Pointer to a link embedded in a user struct
+ * @return      Pointer to the node standing for the link or NULL if failed
+ * @brief       Prepare an embedded link to be used as an idle node. The node
+ *              works with all link and iteration functions but its memory
+ *              belongs to the caller, so list_node_free, list_flush and
+ *              list_destroy never free it.
+ *****************************************************************************/
+void *list_link_init( node_head_t *psLink )
+{
+    if( psLink ) {
+        psLink->m_psList = NULL;
+        psLink->m_uiSize = 0;
+        psLink->m_uiFlags = _NODE_F_EXTERN;
+        return _TO_USER_ADDR(psLink);
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_node_free
+ * @param [in]  pvNode - Pointer to a node
+ * @return      None
+ * @brief       Free the memory of the given node. A pooled node goes back to
+ *              its pool and an embedded link is left untouched.
+ *****************************************************************************/
+void list_node_free( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( _IS_IDLE_NODE(psHead) ) {
+        _node_release( psHead );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_node_size
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      The size of user data field
+ * @brief       Get the size of user data field within the given node
+ *****************************************************************************/
+uint32_t list_node_size( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    return ( (_IS_NODE(psHead))?(psHead->m_uiSize):(0) );
+}
+
+/**************************************************************************//**
+ * @fn          list_node_resize
+ * @param [in]  pvNode - Pointer to a node
+ * @param [in]  uiSize - New size of user data field
+ * @return      Pointer to the node, which may have moved, or NULL if failed
+ * @brief       Change the size of user data field of a node, keeping its
+ *              place in a list and the data up to the smaller size. A node
+ *              stays where it is if its memory is large enough: a node of
+ *              list_node_alloc is grown by realloc, a node of the node cache
+ *              up to its size class and a pooled node up to the node size of
+ *              the pool. Otherwise it moves to a node of list_node_alloc,
+ *              which is not possible in a pool backed list. Nodes of a list
+ *              with an index or a skip list are moved rather than realloced
+ *              so that the overlays can follow. On failure the node is left
+ *              as it was. Embedded links can not be resized.
+ *****************************************************************************/
+void *list_node_resize( void *pvNode, uint32_t uiSize )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    node_head_t *psNew;
+    list_pool_t *psPool;
+    list_entry_t *psOwner;
+    void *pvNew;
+    uint32_t uiRoom;
+    if( !_IS_NODE(psHead) || _IS_EXTERN(psHead) || _IS_MAPPED(psHead) || _IS_HELD(psHead) ) {
+        return NULL;
+    }
+    psPool = _NODE_POOL(psHead);
+    psOwner = psHead->m_psList;
+    if( !psPool && !(psOwner && _HAS_HOOK(psOwner)) ) {
+        psNew = realloc( psHead, _HEAD_SIZE + uiSize );
+        if( !psNew ) {
+            return NULL;
+        }
+        if( psNew != psHead && psOwner ) {
+            psNew->m_psNext->m_stHead.m_psPrev = (void *)psNew;
+            psNew->m_psPrev->m_stHead.m_psNext = (void *)psNew;
+        }
+        _stats_resize( psOwner, psNew->m_uiSize, uiSize );
+        psNew->m_uiSize = uiSize;
+        return _TO_USER_ADDR(psNew);
+    }
+    if( !psPool || psPool->m_uiKind == _POOL_BLOCK ) {
+        uiRoom = psHead->m_uiSize;
+    } else {
+        uiRoom = psPool->m_uiNodeSize;
+    }
+    if( uiSize <= uiRoom ) {
+        _stats_resize( psOwner, psHead->m_uiSize, uiSize );
+        psHead->m_uiSize = uiSize;
+        return pvNode;
+    }
+    if( psOwner && _LIST_POOL(psOwner) ) {
+        return NULL;
+    }
+    pvNew = list_node_alloc( uiSize );
+    if( !pvNew ) {
+        return NULL;
+    }
+    psNew = _TO_HEAD_ADDR(pvNew);
+    memcpy( pvNew, pvNode, psHead->m_uiSize );
+    if( psOwner ) {
+        _stats_resize( psOwner, psHead->m_uiSize, uiSize );
+        _node_replace( psHead, psNew );
+        _hook_move( psOwner, psHead, psNew );
+    }
+    _node_release( psHead );
+    return pvNew;
+}
+
+/**************************************************************************//**
+ * @fn          list_add_rear
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node
+ * @return      None
+ * @brief       Add a node at the end of a list
+ *****************************************************************************/
+void list_add_rear( void *pvListEntry, void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    if( _IS_RW_ENTRY(psList) && _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead) ) {
+        psHead->m_psList = _OWNER(psList);
+        psHead->m_psPrev = psList->m_psPrev;
+        psHead->m_psNext = (void *)psList;
+        psList->m_psPrev->m_stHead.m_psNext = (void *)psHead;
+        psList->m_psPrev = (void *)psHead;
+        psList->m_uiSize++;
+        _hook_link( psHead->m_psList, psHead );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_add_front
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node.
+ * @return      None
+ * @brief       Add a node at the beginning of a list.
+ *****************************************************************************/
+void list_add_front( void *pvListEntry, void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    if( _IS_RW_ENTRY(psList) && _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead) ) {
+        psHead->m_psList = _OWNER(psList);
+        psHead->m_psPrev = (void *)psList;
+        psHead->m_psNext = psList->m_psNext;
+        psList->m_psNext->m_stHead.m_psPrev = (void *)psHead;
+        psList->m_psNext = (void *)psHead;
+        psList->m_uiSize++;
+        _hook_link( psHead->m_psList, psHead );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_add_rear_batch
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  ppvNodes    - Array of nodes
+ * @param [in]  uiNodes     - Number of nodes in the array
+ * @return      The number of nodes added
+ * @brief       Add nodes at the end of a list in array order. The list is
+ *              checked once and the nodes are chained up before being hung
+ *              into the list in one step. Nodes which list_add_rear would
+ *              refuse are skipped.
+ *****************************************************************************/
+uint32_t list_add_rear_batch( void *pvListEntry, void **ppvNodes, uint32_t uiNodes )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_entry_t *psOwner;
+    node_head_t *psHead;
+    node_head_t *psTail;
+    uint32_t uiCount = 0;
+    uint32_t i;
+    if( !_IS_RW_ENTRY(psList) || !ppvNodes ) {
+        return 0;
+    }
+    psOwner = _OWNER(psList);
+    if( _HAS_HOOK(psOwner) ) {
+        /* The overlays follow the nodes one at a time */
+        for( i = 0; i < uiNodes; i++ ) {
+            psHead = _TO_HEAD_ADDR(ppvNodes[i]);
+            if( _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead) ) {
+                list_add_rear( pvListEntry, ppvNodes[i] );
+                uiCount++;
+            }
+        }
+        return uiCount;
+    }
+    psTail = (void *)psList->m_psPrev;
+    for( i = 0; i < uiNodes; i++ ) {
+        psHead = _TO_HEAD_ADDR(ppvNodes[i]);
+        if( _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead) ) {
+            psHead->m_psList = psOwner;
+            psHead->m_psPrev = (void *)psTail;
+            psTail->m_psNext = (void *)psHead;
+            psTail = psHead;
+            _stats_link( psOwner, psHead );
+            uiCount++;
+        }
+    }
+    psTail->m_psNext = (void *)psList;
+    psList->m_psPrev = (void *)psTail;
+    psList->m_uiSize += uiCount;
+    return uiCount;
+}
+
+/**************************************************************************//**
+ * @fn          list_insert_before
+ * @param [in]  pvNodeA - Pointer to a node.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Insert a node before another node.
+ *****************************************************************************/
+void list_insert_before( void *pvNodeA, void *pvNodeB )
+{
+    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
+    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
+    if( _IS_RW_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB)
+        && _POOL_MATCH(psHeadA->m_psList, psHeadB) ) {
+        psHeadB->m_psList = psHeadA->m_psList;
+        psHeadB->m_psNext = (void *)psHeadA;
+        psHeadB->m_psPrev = psHeadA->m_psPrev;
+        psHeadA->m_psPrev->m_stHead.m_psNext = (void *)psHeadB;
+        psHeadA->m_psPrev = (void *)psHeadB;
+        if( !_IS_ANON(psHeadA->m_psList) ) {
+            psHeadA->m_psList->m_uiSize++;
+        }
+        _hook_link( psHeadB->m_psList, psHeadB );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          ilst_insert_after
+ * @param [in]  pvNodeA - Pointer to a node.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Insert a node after another node.
+ *****************************************************************************/
+void ilst_insert_after( void *pvNodeA, void *pvNodeB )
+{
+    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
+    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
+    if( _IS_RW_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB)
+        && _POOL_MATCH(psHeadA->m_psList, psHeadB) ) {
+        psHeadB->m_psList = psHeadA->m_psList;
+        psHeadB->m_psPrev = (void *)psHeadA;
+        psHeadB->m_psNext = psHeadA->m_psNext;
+        psHeadA->m_psNext->m_stHead.m_psPrev = (void *)psHeadB;
+        psHeadA->m_psNext = (void *)psHeadB;
+        if( !_IS_ANON(psHeadA->m_psList) ) {
+            psHeadA->m_psList->m_uiSize++;
+        }
+        _hook_link( psHeadB->m_psList, psHeadB );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_node_del
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      None
+ * @brief       Delete a node from list. Note the node will not be freed.
+ *****************************************************************************/
+void list_node_del( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( _IS_RW_NODE(psHead) ) {
+        psHead->m_psPrev->m_stHead.m_psNext = psHead->m_psNext;
+        psHead->m_psNext->m_stHead.m_psPrev = psHead->m_psPrev;
+        if( !_IS_ANON(psHead->m_psList) ) {
+            psHead->m_psList->m_uiSize--;
+        }
+        _hook_unlink( psHead->m_psList, psHead );
+        psHead->m_psList = NULL;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_node_swap
+ * @param [in]  pvNodeA - Pointer to a node.
+ * @param [in]  pvNodeB - Pointer to another node.
+ * @return      None
+ * @brief       Swap two nodes
+ *****************************************************************************/
+void list_node_swap( void *pvNodeA, void *pvNodeB )
+{
+    node_head_t sTmp;
+    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
+    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
+    list_entry_t *psListA;
+    list_entry_t *psListB;
+    node_head_t *psPrevA;
+    node_head_t *psPrevB;
+    if( !_IS_NODE(psHeadA) || !_IS_NODE(psHeadB) || psHeadA == psHeadB
+        || _IS_MAPPED(psHeadA) || _IS_MAPPED(psHeadB) || _IS_HELD(psHeadA) || _IS_HELD(psHeadB) ) {
+        return;
+    }
+    if( (psHeadA->m_psList && !_POOL_MATCH(psHeadA->m_psList, psHeadB))
+        || (psHeadB->m_psList && !_POOL_MATCH(psHeadB->m_psList, psHeadA)) ) {
+        return;
+    }
+    psListA = psHeadA->m_psList;
+    psListB = psHeadB->m_psList;
+    if( _IS_IDLE_NODE(psHeadA) ) {
+        if( _IS_USED_NODE(psHeadB) ) {
+            _hook_unlink( psListB, psHeadB );
+            _node_replace( psHeadB, psHeadA );
+            _hook_link( psListB, psHeadA );
+        }
+    } else if( _IS_IDLE_NODE(psHeadB) ) {
+        _hook_unlink( psListA, psHeadA );
+        _node_replace( psHeadA, psHeadB );
+        _hook_link( psListA, psHeadB );
+    } else if( (void *)psHeadA->m_psNext == (void *)psHeadB ) {
+        list_node_del( pvNodeB );
+        list_insert_before( pvNodeA, pvNodeB );
+    } else if( (void *)psHeadB->m_psNext == (void *)psHeadA ) {
+        list_node_del( pvNodeA );
+        list_insert_before( pvNodeB, pvNodeA );
+    } else if( _HAS_HOOK(psListA) || _HAS_HOOK(psListB) ) {
+        /* Move them one at a time so that the overlays can follow */
+        psPrevA = (void *)psHeadA->m_psPrev;
+        psPrevB = (void *)psHeadB->m_psPrev;
+        list_node_del( pvNodeA );
+        list_node_del( pvNodeB );
+        _node_put_after( psPrevA, pvNodeB );
+        _node_put_after( psPrevB, pvNodeA );
+    } else {
+        _node_replace( psHeadA, &sTmp );
+        _node_replace( psHeadB, psHeadA );
+        _node_replace( &sTmp, psHeadB );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_splice
+ * @param [in]  pvListEntry - List handle of the destination
+ * @param [in]  pvPos       - Node of the destination to put the range before,
+ *                            NULL to put it at the end. It must not be in
+ *                            the range.
+ * @param [in]  pvFirst     - First node of the range
+ * @param [in]  pvLast      - Last node of the range, in the same list and not
+ *                            before pvFirst
+ * @return      None
+ * @brief       Move a range of nodes into a list. The chain is relinked at
+ *              its ends in constant time. The nodes are walked once only when
+ *              they have to record a new owner, that is when moving between
+ *              two different lists not created with LIST_OPT_NO_OWNER. The
+ *              range is not walked to check the arguments, so the caller
+ *              must keep pvPos out of the range and pvLast behind pvFirst,
+ *              and for lists created with LIST_OPT_NO_OWNER, which do not
+ *              know their nodes, keep pvPos in the destination.
+ *****************************************************************************/
+void list_splice( void *pvListEntry, void *pvPos, void *pvFirst, void *pvLast )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psPos = pvPos?_TO_HEAD_ADDR(pvPos):psList;
+    node_head_t *psFirst = _TO_HEAD_ADDR(pvFirst);
+    node_head_t *psLast = _TO_HEAD_ADDR(pvLast);
+    list_entry_t *psSrc;
+    list_entry_t *psDst;
+    uint32_t uiCount;
+    if( !_IS_RW_ENTRY(psList) || !_IS_RW_NODE(psFirst) || !_IS_USED_NODE(psLast) ) {
+        return;
+    }
+    psSrc = psFirst->m_psList;
+    psDst = _OWNER(psList);
+    if( psLast->m_psList != psSrc || psPos == psFirst || psPos == psLast
+        || (pvPos && (!_IS_USED_NODE(psPos) || psPos->m_psList != psDst))
+        || (_LIST_POOL(psList) && _LIST_POOL(psSrc) != _LIST_POOL(psList)) ) {
+        return;
+    }
+    _hook_reorder( psSrc );
+    _hook_reorder( psDst );
+    if( psSrc != psDst ) {
+        uiCount = _chain_adopt( psFirst, psLast, psDst );
+        if( !_IS_ANON(psSrc) ) {
+            psSrc->m_uiSize -= uiCount;
+        }
+        psList->m_uiSize += uiCount;
+    }
+    _chain_move( psPos, psFirst, psLast );
+}
+
+/**************************************************************************//**
+ * @fn          list_concat
+ * @param [in]  pvListEntry - List handle of the destination
+ * @param [in]  pvSource    - List handle of the source
+ * @return      None
+ * @brief       Move all nodes of a list to the end of another list. See
+ *              list_splice for the cost.
+ *****************************************************************************/
+void list_concat( void *pvListEntry, void *pvSource )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_entry_t *psSrc = _TO_HEAD_ADDR(pvSource);
+    uint32_t uiCount;
+    if( !_IS_RW_ENTRY(psList) || !_IS_RW_ENTRY(psSrc) || psList == psSrc || !_HAS_NODE(psSrc)
+        || (_LIST_POOL(psList) && _LIST_POOL(psSrc) != _LIST_POOL(psList)) ) {
+        return;
+    }
+    _hook_reorder( _OWNER(psSrc) );
+    _hook_reorder( _OWNER(psList) );
+    if( _OWNER(psSrc) != _OWNER(psList) ) {
+        uiCount = _chain_adopt( (void *)psSrc->m_psNext, (void *)psSrc->m_psPrev, _OWNER(psList) );
+        psList->m_uiSize += uiCount;
+    }
+    _chain_move( psList, (void *)psSrc->m_psNext, (void *)psSrc->m_psPrev );
+    psSrc->m_uiSize = 0;
+}
+
+/**************************************************************************//**
+ * @fn          list_split_after
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node of the list
+ * @return      Handle of a new list holding the nodes after the given node
+ *              or NULL if failed
+ * @brief       Split a list in two after a node. The new list has the same
+ *              pool and options as the given one. See list_splice for the
+ *              cost.
+ *****************************************************************************/
+void *list_split_after( void *pvListEntry, void *pvNode )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    list_entry_t *psNew;
+    void *pvNew;
+    uint32_t uiCount;
+    if( !_IS_RW_ENTRY(psList) || !_IS_USED_NODE(psHead) || psHead->m_psList != _OWNER(psList) ) {
+        return NULL;
+    }
+    pvNew = list_create_ex( _LIST_POOL(psList),
+                            (psList->m_uiFlags & _LIST_F_NO_OWNER)?LIST_OPT_NO_OWNER:0 );
+    psNew = _TO_HEAD_ADDR(pvNew);
+    if( psNew && (void *)psHead->m_psNext != (void *)psList ) {
+        if( !_IS_ANON(psHead->m_psList) ) {
+            _hook_reorder( psList );
+            uiCount = _chain_adopt( (void *)psHead->m_psNext, (void *)psList->m_psPrev, psNew );
+            psList->m_uiSize -= uiCount;
+            psNew->m_uiSize = uiCount;
+        }
+        _chain_move( psNew, (void *)psHead->m_psNext, (void *)psList->m_psPrev );
+    }
+    return pvNew;
+}
+
+/**************************************************************************//**
+ * @fn          list_node_first
+ * @param [in]  pvListEntry  - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Get the node at the beginning of the specified list.
+ *****************************************************************************/
+void *list_node_first( void *pvListEntry )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    return (_IS_ENTRY(psList)&&_HAS_NODE(psList))?_TO_USER_ADDR(psList->m_psNext):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_node_last
+ * @param [in]  pvListEntry - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Get the node at the end of the specified list.
+ *****************************************************************************/
+void *list_node_last( void *pvListEntry )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    return (_IS_ENTRY(psList)&&_HAS_NODE(psList))?_TO_USER_ADDR(psList->m_psPrev):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          list_node_next
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the the next node
+ * @brief       Get next node or NULL if reach the end of list
+ *****************************************************************************/
+void *list_node_next( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( !_NOT_LAST_NODE(psHead) ) {
+        return NULL;
+    }
+    return _TO_USER_ADDR(psHead->m_psNext);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_prev
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the the previous node
+ * @brief       Get next node or NULL if reach the beginning of list
+ *****************************************************************************/
+void *list_node_prev( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( !_NOT_FIRST_NODE(psHead) ) {
+        return NULL;
+    }
+    return _TO_USER_ADDR(psHead->m_psPrev);
+}
+
+/**************************************************************************//**
+ * @fn          list_for_each
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every node in order
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list. The list is checked once instead of
+ *              on every step, and nodes are prefetched a few steps ahead of
+ *              the visitor. The visitor may delete or free the node it is
+ *              given but no other node.
+ *****************************************************************************/
+void list_for_each( void *pvListEntry, list_visit_t pfnVisit, void *pvCtx )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    node_head_t *psNext;
+    node_head_t *psLead;
+    uint32_t uiSteps = 0;
+    uint32_t i;
+    if( !_IS_ENTRY(psList) || !pfnVisit ) {
+        return;
+    }
+    psHead = (void *)psList->m_psNext;
+    for( psLead = psHead, i = 0; psLead != psList && i < _PREFETCH_AHEAD; i++ ) {
+        psLead = (void *)psLead->m_psNext;
+        __builtin_prefetch( psLead );
+    }
+    while( psHead != psList ) {
+        psNext = (void *)psHead->m_psNext;
+        if( psLead != psList ) {
+            psLead = (void *)psLead->m_psNext;
+            __builtin_prefetch( psLead );
+        }
+        uiSteps++;
+        if( pfnVisit( _TO_USER_ADDR(psHead), pvCtx ) ) {
+            break;
+        }
+        psHead = psNext;
+    }
+    _STATS_ADD(psList, m_ulNext, uiSteps);
+}
+
+/**************************************************************************//**
+ * @fn          list_for_each_reverse
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every node from the end
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list backwards, like list_for_each
+ *****************************************************************************/
+void list_for_each_reverse( void *pvListEntry, list_visit_t pfnVisit, void *pvCtx )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    node_head_t *psPrev;
+    node_head_t *psLead;
+    uint32_t uiSteps = 0;
+    uint32_t i;
+    if( !_IS_ENTRY(psList) || !pfnVisit ) {
+        return;
+    }
+    psHead = (void *)psList->m_psPrev;
+    for( psLead = psHead, i = 0; psLead != psList && i < _PREFETCH_AHEAD; i++ ) {
+        psLead = (void *)psLead->m_psPrev;
+        __builtin_prefetch( psLead );
+    }
+    while( psHead != psList ) {
+        psPrev = (void *)psHead->m_psPrev;
+        if( psLead != psList ) {
+            psLead = (void *)psLead->m_psPrev;
+            __builtin_prefetch( psLead );
+        }
+        uiSteps++;
+        if( pfnVisit( _TO_USER_ADDR(psHead), pvCtx ) ) {
+            break;
+        }
+        psHead = psPrev;
+    }
+    _STATS_ADD(psList, m_ulPrev, uiSteps);
+}
+
+/**************************************************************************//**
+ * @fn          list_for_each_batch
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every batch of nodes in order
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list, handing them to the visitor up to
+ *              16 at a time. The chain is followed and the user data fields
+ *              are prefetched while a batch is gathered, so the visitor
+ *              works on data already on its way. The visitor may delete or
+ *              free the nodes of its batch but no other node.
+ *****************************************************************************/
+void list_for_each_batch( void *pvListEntry, list_batch_t pfnVisit, void *pvCtx )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    void *apvNode[_BATCH_NODES];
+    uint32_t uiSteps = 0;
+    uint32_t uiCount;
+    if( !_IS_ENTRY(psList) || !pfnVisit ) {
+        return;
+    }
+    psHead = (void *)psList->m_psNext;
+    while( psHead != psList ) {
+        for( uiCount = 0; uiCount < _BATCH_NODES && psHead != psList; uiCount++ ) {
+            apvNode[uiCount] = _TO_USER_ADDR(psHead);
+            __builtin_prefetch( apvNode[uiCount] );
+            psHead = (void *)psHead->m_psNext;
+        }
+        uiSteps += uiCount;
+        if( pfnVisit( apvNode, uiCount, pvCtx ) ) {
+            break;
+        }
+    }
+    _STATS_ADD(psList, m_ulNext, uiSteps);
+}
+
+/**************************************************************************//**
+ * @fn          list_length
+ * @param [in]  pvListEntry - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Get the number of nodes in a list. It takes a walk on a list
+ *              created with LIST_OPT_NO_OWNER.
+ *****************************************************************************/
+uint32_t list_length( void *pvListEntry )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    uint32_t uiSize = 0;
+    if( !_IS_ENTRY(psList) ) {
+        return 0;
+    }
+    if( !(psList->m_uiFlags & _LIST_F_NO_OWNER) ) {
+        return psList->m_uiSize;
+    }
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        uiSize++;
+    }
+    return uiSize;
+}
+
+/**************************************************************************//**
+ * @fn          list_sort
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnCmp      - Compare function on user data fields
+ * @return      None
+ * @brief       Sort a list in place with a stable bottom-up merge sort. The
+ *              nodes are relinked, nothing is allocated or copied.
+ *****************************************************************************/
+void list_sort( void *pvListEntry, list_cmp_t pfnCmp )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    if( _IS_RW_ENTRY(psList) && pfnCmp && psList->m_psNext != psList->m_psPrev ) {
+        _hook_reorder( _OWNER(psList) );
+        psList->m_psPrev->m_stHead.m_psNext = NULL;
+        _sort_relink( psList, _sort_chain( (void *)psList->m_psNext, pfnCmp ) );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_sort_parallel
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnCmp      - Compare function on user data fields
+ * @param [in]  uiThreads   - Number of threads to use
+ * @return      None
+ * @brief       Sort a list like list_sort using several threads. The chain
+ *              is cut into one run per thread, the runs are sorted in
+ *              parallel and then merged pairwise, also in parallel. The
+ *              compare function must be safe to call from several threads.
+ *****************************************************************************/
+void list_sort_parallel( void *pvListEntry, list_cmp_t pfnCmp, uint32_t uiThreads )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    sort_job_t asJob[_SORT_MAX_THREADS];
+    node_head_t *psHead;
+    node_head_t *psTail;
+    uint32_t uiSize;
+    uint32_t uiRun;
+    uint32_t uiLen;
+    uint32_t uiJobs;
+    uint32_t i;
+    uint32_t j;
+    if( !_IS_RW_ENTRY(psList) || !pfnCmp ) {
+        return;
+    }
+    if( uiThreads > _SORT_MAX_THREADS ) {
+        uiThreads = _SORT_MAX_THREADS;
+    }
+    uiSize = list_length( pvListEntry );
+    if( uiThreads > uiSize / _SORT_MIN_RUN ) {
+        uiThreads = uiSize / _SORT_MIN_RUN;
+    }
+    if( uiThreads < 2 ) {
+        list_sort( pvListEntry, pfnCmp );
+        return;
+    }
+    /* Cut the chain into runs of nearly equal length */
+    uiRun = uiSize / uiThreads;
+    psHead = (void *)psList->m_psNext;
+    for( i = 0; i < uiThreads; i++ ) {
+        asJob[i].m_psChain = psHead;
+        asJob[i].m_psOther = NULL;
+        asJob[i].m_pfnCmp = pfnCmp;
+        uiLen = (i < uiThreads - 1)?uiRun:(uiSize - uiRun * i);
+        for( j = 1; j < uiLen; j++ ) {
+            psHead = (void *)psHead->m_psNext;
+        }
+        psTail = psHead;
+        psHead = (void *)psHead->m_psNext;
+        psTail->m_psNext = NULL;
+    }
+    _sort_run_jobs( asJob, uiThreads );
+    /* Merge neighbouring runs pairwise until one is left */
+    for( uiJobs = uiThreads; uiJobs > 1; uiJobs = (uiJobs + 1) / 2 ) {
+        for( i = 0; i < uiJobs / 2; i++ ) {
+            asJob[i].m_psChain = asJob[2 * i].m_psChain;
+            asJob[i].m_psOther = asJob[2 * i + 1].m_psChain;
+        }
+        if( uiJobs & 1 ) {
+            asJob[i].m_psChain = asJob[uiJobs - 1].m_psChain;
+            asJob[i].m_psOther = NULL;
+        }
+        _sort_run_jobs( asJob, uiJobs / 2 );
+    }
+    _hook_reorder( _OWNER(psList) );
+    _sort_relink( psList, asJob[0].m_psChain );
+}
+
+/**************************************************************************//**
+ * @fn          list_index_create
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnKey      - Function giving the key within a user data field
+ * @param [in]  pfnHash     - Hash function on keys
+ * @param [in]  pfnEq       - Equality function on keys
+ * @return      true if created, false if failed
+ * @brief       Attach a hash index to a list for list_find. The index follows
+ *              every add, insert, delete, move and flush of the list. A list
+ *              has at most one index and a new one replaces the old one. A
+ *              list created with LIST_OPT_NO_OWNER can not be indexed.
+ *****************************************************************************/
+bool list_index_create( void *pvListEntry, list_key_t pfnKey, list_hash_t pfnHash, list_eq_t pfnEq )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_index_t *psIndex;
+    if( !_IS_RW_ENTRY(psList) || _IS_ANON(_OWNER(psList)) || !pfnKey || !pfnHash || !pfnEq ) {
+        return false;
+    }
+    psIndex = calloc( 1, sizeof( list_index_t ) );
+    if( !psIndex ) {
+        return false;
+    }
+    psIndex->m_pfnKey = pfnKey;
+    psIndex->m_pfnHash = pfnHash;
+    psIndex->m_pfnEq = pfnEq;
+    if( !_index_rebuild( psList, psIndex ) ) {
+        free( psIndex );
+        return false;
+    }
+    list_index_destroy( pvListEntry );
+    _CTRL(psList)->m_psIndex = psIndex;
+    psList->m_uiFlags |= _LIST_F_HOOKED;
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          list_index_destroy
+ * @param [in]  pvListEntry - List handle
+ * @return      None
+ * @brief       Detach and free the hash index of a list if any
+ *****************************************************************************/
+void list_index_destroy( void *pvListEntry )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_index_t *psIndex;
+    if( !_IS_ENTRY(psList) || _IS_ANON(_OWNER(psList)) ) {
+        return;
+    }
+    psIndex = _CTRL(psList)->m_psIndex;
+    if( psIndex ) {
+        _CTRL(psList)->m_psIndex = NULL;
+        if( !_CTRL(psList)->m_psSkip ) {
+            psList->m_uiFlags &= ~_LIST_F_HOOKED;
+        }
+        if( !psIndex->m_bShared ) {
+            free( psIndex->m_psSlot );
+        }
+        free( psIndex );
+    }
+}
 
 /**************************************************************************//**
- * @fn          list_create
- * @param       None
- * @return      Handle of the created list or NULL if failed
- * @brief       Create a new empty list
+ * @fn          list_index_reserve
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  uiNodes     - Number of nodes to make room for
+ * @return      true if done, false if there is no index or out of memory
+ * @brief       Grow the hash index of a list once so that it holds the given
+ *              number of nodes without growing again
  *****************************************************************************/
-void *list_create( void )
+bool list_index_reserve( void *pvListEntry, uint32_t uiNodes )
 {
-    list_entry_t *psList = malloc( sizeof( list_entry_t ) );
-    if( psList ) {
-        psList->m_psNext =  (void *)psList;
-        psList->m_psPrev =  (void *)psList;
-        psList->m_psList =  (void *)psList;
-        psList->m_uiSize = 0;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_index_t *psIndex;
+    uint32_t uiSlots;
+    if( !_IS_ENTRY(psList) || !_CTRL(psList)->m_psIndex ) {
+        return false;
+    }
+    psIndex = _CTRL(psList)->m_psIndex;
+    if( psIndex->m_bStale && !_index_rebuild( psList, psIndex ) ) {
+        return false;
+    }
+    for( uiSlots = psIndex->m_uiMask + 1; _INDEX_FULL(uiNodes, uiSlots); uiSlots *= 2 ) {
+        if( uiSlots >= 0x80000000u ) {
+            return false;
+        }
     }
-    return _TO_USER_ADDR(psList);
+    return (uiSlots == psIndex->m_uiMask + 1) || _index_resize( psIndex, uiSlots, NULL );
 }
 
 /**************************************************************************//**
- * @fn          list_node_alloc
- * @param [in]  uiSize - Expected size of user data field
- * @return      Pointer to the created node or NULL if failed
- * @brief       Create a new element node with specified size of user data field
+ * @fn          list_reserve
+ * @param [in]  pvListEntry - Handle of a list created by list_create_from
+ * @param [in]  uiNodes     - Number of nodes to make room for
+ * @return      true if done, false if the list has no pool or out of memory
+ * @brief       Make room for more nodes in a pool backed list with one
+ *              allocation. The nodes are carved into the pool and the slots
+ *              of the hash index, if any, are placed behind them, so that
+ *              neither grows again until the list holds more. The slots
+ *              belong to the pool then, which must outlive the index.
  *****************************************************************************/
-void *list_node_alloc( uint32_t uiSize )
+bool list_reserve( void *pvListEntry, uint32_t uiNodes )
 {
-    list_node_t *psNode = NULL;
-    psNode = malloc( _HEAD_SIZE + uiSize );
-    if( psNode ) {
-        psNode->m_stHead.m_uiSize  = uiSize;
-        psNode->m_stHead.m_psList = NULL;
-        return (void *)psNode->m_pData;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_pool_t *psPool;
+    list_index_t *psIndex;
+    index_slot_t *psSlot;
+    uint32_t uiSlots = 0;
+    if( !_IS_RW_ENTRY(psList) || !uiNodes || uiNodes > UINT32_MAX - psList->m_uiSize ) {
+        return false;
     }
-    return NULL;
+    psPool = _LIST_POOL(psList);
+    psIndex = _CTRL(psList)->m_psIndex;
+    if( !psPool || psPool->m_uiKind != _POOL_CHUNK
+        || (psIndex && psIndex->m_bStale && !_index_rebuild( psList, psIndex )) ) {
+        return false;
+    }
+    if( psIndex ) {
+        for( uiSlots = psIndex->m_uiMask + 1; _INDEX_FULL(psList->m_uiSize + uiNodes, uiSlots); uiSlots *= 2 ) {
+            if( uiSlots >= 0x80000000u ) {
+                return false;
+            }
+        }
+        if( psIndex->m_bShared && uiSlots == psIndex->m_uiMask + 1 ) {
+            uiSlots = 0;
+        }
+    }
+    psSlot = _pool_grow( psPool, uiNodes, (size_t)uiSlots * sizeof( index_slot_t ) );
+    if( !psSlot ) {
+        return false;
+    }
+    if( uiSlots ) {
+        memset( psSlot, 0, (size_t)uiSlots * sizeof( index_slot_t ) );
+        _index_resize( psIndex, uiSlots, psSlot );
+    }
+    return true;
 }
 
 /**************************************************************************//**
- * @fn          list_node_free
- * @param [in]  pvNode - Pointer to a node
- * @return      None
- * @brief       Free the memory of the given node
+ * @fn          list_find
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvKey       - Pointer to the key to look for
+ * @return      Pointer to a node with the key or NULL if not founded
+ * @brief       Find a node by key through the hash index of a list. If the
+ *              index once ran out of memory it is rebuilt here, and the list
+ *              is scanned when that fails too.
  *****************************************************************************/
-void list_node_free( void *pvNode )
+void *list_find( void *pvListEntry, const void *pvKey )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
-    if( _IS_IDLE_NODE(psHead) ) {
-        free( psHead );
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_index_t *psIndex;
+    index_slot_t *psSlot;
+    node_head_t *psHead;
+    uint32_t uiHash;
+    uint32_t i;
+    if( !_IS_ENTRY(psList) || !_CTRL(psList)->m_psIndex ) {
+        return NULL;
+    }
+    psIndex = _CTRL(psList)->m_psIndex;
+    if( psIndex->m_bStale && !_index_rebuild( psList, psIndex ) ) {
+        for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+            if( psIndex->m_pfnEq( psIndex->m_pfnKey( _TO_USER_ADDR(psHead) ), pvKey ) ) {
+                return _TO_USER_ADDR(psHead);
+            }
+        }
+        return NULL;
+    }
+    uiHash = _index_mix( psIndex->m_pfnHash( pvKey ) );
+    psSlot = psIndex->m_psSlot;
+    for( i = uiHash & psIndex->m_uiMask; psSlot[i].m_psNode; i = (i + 1) & psIndex->m_uiMask ) {
+        if( psSlot[i].m_uiHash == uiHash
+            && psIndex->m_pfnEq( psIndex->m_pfnKey( _TO_USER_ADDR(psSlot[i].m_psNode) ), pvKey ) ) {
+            return _TO_USER_ADDR(psSlot[i].m_psNode);
+        }
     }
+    return NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_node_size
- * @param [in]  pvNode - Pointer to a node.
- * @return      The size of user data field
- * @brief       Get the size of user data field within the given node
+ * @fn          list_skip_create
+ * @param [in]  pvListEntry - List handle
+ * @return      true if created, false if failed
+ * @brief       Attach an order statistic skip list to a list, which makes
+ *              list_node_at and list_node_index O(log n) on average. It is
+ *              kept up by every add, insert, delete and swap. After a sort,
+ *              splice, concat or split it is rebuilt in O(n) on next use.
+ *              A list created with LIST_OPT_NO_OWNER can not have one.
  *****************************************************************************/
-uint32_t list_node_size( void *pvNode )
+bool list_skip_create( void *pvListEntry )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
-    return ( (_IS_NODE(psHead))?(psHead->m_uiSize):(0) );
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_skip_t *psSkip;
+    if( !_IS_RW_ENTRY(psList) || _IS_ANON(_OWNER(psList)) ) {
+        return false;
+    }
+    if( _CTRL(psList)->m_psSkip ) {
+        return true;
+    }
+    psSkip = calloc( 1, sizeof( list_skip_t ) );
+    if( !psSkip ) {
+        return false;
+    }
+    psSkip->m_uiSeed = (uint32_t)(uintptr_t)psSkip | 1;
+    _CTRL(psList)->m_psSkip = psSkip;
+    psList->m_uiFlags |= _LIST_F_HOOKED;
+    _skip_rebuild( psList );
+    return true;
 }
 
 /**************************************************************************//**
- * @fn          list_add_rear
+ * @fn          list_skip_destroy
  * @param [in]  pvListEntry - List handle
- * @param [in]  pvNode      - Pointer to a node
  * @return      None
- * @brief       Add a node at the end of a list
+ * @brief       Detach and free the skip list of a list if any
  *****************************************************************************/
-void list_add_rear( void *pvListEntry, void *pvNode )
+void list_skip_destroy( void *pvListEntry )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    if( _IS_ENTRY(psList) && _IS_IDLE_NODE(psHead) ) {
-        psHead->m_psList = psList;
-        psHead->m_psPrev = psList->m_psPrev;
-        psHead->m_psNext = (void *)psList;
-        psList->m_psPrev->m_stHead.m_psNext = (void *)psHead;
-        psList->m_psPrev = (void *)psHead;
-        psList->m_uiSize++;
+    if( !_IS_ENTRY(psList) || !_HAS_SKIP(_OWNER(psList)) ) {
+        return;
+    }
+    _skip_clear( psList );
+    free( _CTRL(psList)->m_psSkip->m_ppsTower );
+    free( _CTRL(psList)->m_psSkip );
+    _CTRL(psList)->m_psSkip = NULL;
+    if( !_CTRL(psList)->m_psIndex ) {
+        psList->m_uiFlags &= ~_LIST_F_HOOKED;
     }
 }
 
 /**************************************************************************//**
- * @fn          list_add_front
+ * @fn          list_node_at
  * @param [in]  pvListEntry - List handle
- * @param [in]  pvNode      - Pointer to a node.
- * @return      None
- * @brief       Add a node at the beginning of a list.
+ * @param [in]  uiIndex     - Position of the node from 0
+ * @return      Pointer to the node or NULL if out of range
+ * @brief       Get the node at a position, in O(log n) with a skip list and
+ *              by walking the list otherwise
  *****************************************************************************/
-void list_add_front( void *pvListEntry, void *pvNode )
+void *list_node_at( void *pvListEntry, uint32_t uiIndex )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    if( _IS_ENTRY(psList) && _IS_IDLE_NODE(psHead) ) {
-        psHead->m_psList = psList;
-        psHead->m_psPrev = (void *)psList;
-        psHead->m_psNext = psList->m_psNext;
-        psList->m_psNext->m_stHead.m_psPrev = (void *)psHead;
-        psList->m_psNext = (void *)psHead;
-        psList->m_uiSize++;
+    node_head_t *psHead = psList;
+    skip_tower_t *psTower = NULL;
+    list_skip_t *psSkip;
+    skip_link_t *psLink;
+    uint32_t uiPos = 0;
+    uint32_t uiLevel;
+    if( !_IS_ENTRY(psList) ) {
+        return NULL;
     }
+    if( _HAS_SKIP(_OWNER(psList)) ) {
+        psSkip = _CTRL(psList)->m_psSkip;
+        if( psSkip->m_bStale ) {
+            _skip_rebuild( psList );
+        }
+        for( uiLevel = psSkip->m_uiLevel; uiLevel > 0; uiLevel-- ) {
+            psLink = _skip_link( psSkip, psTower, uiLevel );
+            while( psLink->m_psNext && uiPos + psLink->m_uiWidth <= uiIndex + 1 ) {
+                uiPos += psLink->m_uiWidth;
+                psTower = psLink->m_psNext;
+                psLink = _skip_link( psSkip, psTower, uiLevel );
+            }
+        }
+        if( psTower ) {
+            psHead = psTower->m_psNode;
+        }
+    }
+    for( ; uiPos <= uiIndex; uiPos++ ) {
+        psHead = (void *)psHead->m_psNext;
+        if( psHead == psList ) {
+            return NULL;
+        }
+    }
+    return _TO_USER_ADDR(psHead);
 }
 
 /**************************************************************************//**
- * @fn          list_insert_before
- * @param [in]  pvNodeA - Pointer to a node.
- * @param [in]  pvNodeB - Pointer to the node to be inserted.
- * @return      None
- * @brief       Insert a node before another node.
+ * @fn          list_node_index
+ * @param [in]  pvNode - Pointer to a node
+ * @return      Position of the node from 0 or LIST_INDEX_NONE if not in list
+ * @brief       Get the position of a node in its list, in O(log n) with a
+ *              skip list and by walking the list otherwise
  *****************************************************************************/
-void list_insert_before( void *pvNodeA, void *pvNodeB )
+uint32_t list_node_index( void *pvNode )
 {
-    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
-    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
-    if( _IS_USED_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB) ) {
-        psHeadB->m_psList = psHeadA->m_psList;
-        psHeadB->m_psNext = (void *)psHeadA;
-        psHeadB->m_psPrev = psHeadA->m_psPrev;
-        psHeadA->m_psPrev->m_stHead.m_psNext = (void *)psHeadB;
-        psHeadA->m_psPrev = (void *)psHeadB;
-        psHeadA->m_psList->m_uiSize++;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    list_skip_t *psSkip;
+    uint32_t uiIndex = 0;
+    if( !_IS_USED_NODE(psHead) ) {
+        return LIST_INDEX_NONE;
+    }
+    if( _HAS_SKIP(psHead->m_psList) ) {
+        psSkip = _CTRL(psHead->m_psList)->m_psSkip;
+        if( psSkip->m_bStale ) {
+            _skip_rebuild( psHead->m_psList );
+        }
+        return _skip_rank( psSkip, psHead ) - 1;
+    }
+    for( ; _NOT_FIRST_NODE(psHead); psHead = (void *)psHead->m_psPrev ) {
+        uiIndex++;
     }
+    return uiIndex;
 }
 
 /**************************************************************************//**
- * @fn          ilst_insert_after
- * @param [in]  pvNodeA - Pointer to a node.
- * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @fn          list_insert_sorted
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to an idle node
+ * @param [in]  pfnCmp      - Compare function on user data fields
  * @return      None
- * @brief       Insert a node after another node.
+ * @brief       Insert a node into a list kept in order, after the nodes equal
+ *              to it. A skip list is attached on first use, so inserts and
+ *              bounds are O(log n) on average. The list stays in order as
+ *              long as nodes are only added by this function.
  *****************************************************************************/
-void ilst_insert_after( void *pvNodeA, void *pvNodeB )
+void list_insert_sorted( void *pvListEntry, void *pvNode, list_cmp_t pfnCmp )
 {
-    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
-    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
-    if( _IS_USED_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB) ) {
-        psHeadB->m_psList = psHeadA->m_psList;
-        psHeadB->m_psPrev = (void *)psHeadA;
-        psHeadB->m_psNext = psHeadA->m_psNext;
-        psHeadA->m_psNext->m_stHead.m_psPrev = (void *)psHeadB;
-        psHeadA->m_psNext = (void *)psHeadB;
-        psHeadA->m_psList->m_uiSize++;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( !_IS_ENTRY(psList) || !_IS_IDLE_NODE(psHead) || !pfnCmp ) {
+        return;
+    }
+    if( !_IS_ANON(_OWNER(psList)) && !_CTRL(psList)->m_psSkip ) {
+        list_skip_create( pvListEntry );
     }
+    _node_put_after( _skip_seek( psList, pvNode, pfnCmp, 0 ), pvNode );
 }
 
 /**************************************************************************//**
- * @fn          list_node_del
- * @param [in]  pvNode - Pointer to a node.
- * @return      None
- * @brief       Delete a node from list. Note the node will not be freed.
+ * @fn          list_lower_bound
+ * @param [in]  pvListEntry - List handle of a sorted list
+ * @param [in]  pvKey       - Key to look for
+ * @param [in]  pfnCmp      - Compare function called with the key and a user
+ *                            data field, like the one of bsearch
+ * @return      Pointer to the first node not less than the key or NULL
+ * @brief       Find where the nodes not less than a key start. A range is
+ *              scanned with list_node_next from the lower bound of its start
+ *              up to the upper bound of its end.
  *****************************************************************************/
-void list_node_del( void *pvNode )
+void *list_lower_bound( void *pvListEntry, const void *pvKey, list_cmp_t pfnCmp )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
-    if( _IS_USED_NODE(psHead) ) {
-        psHead->m_psPrev->m_stHead.m_psNext = psHead->m_psNext;
-        psHead->m_psNext->m_stHead.m_psPrev = psHead->m_psPrev;
-        psHead->m_psList->m_uiSize--;
-        psHead->m_psList = NULL;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    if( !_IS_ENTRY(psList) || !pfnCmp ) {
+        return NULL;
     }
+    psHead = (void *)_skip_seek( psList, pvKey, pfnCmp, 1 )->m_psNext;
+    return (psHead != psList)?_TO_USER_ADDR(psHead):NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_node_swap
- * @param [in]  pvNodeA - Pointer to a node.
- * @param [in]  pvNodeB - Pointer to another node.
- * @return      None
- * @brief       Swap two nodes
+ * @fn          list_upper_bound
+ * @param [in]  pvListEntry - List handle of a sorted list
+ * @param [in]  pvKey       - Key to look for
+ * @param [in]  pfnCmp      - Compare function called with the key and a user
+ *                            data field, like the one of bsearch
+ * @return      Pointer to the first node greater than the key or NULL
+ * @brief       Find where the nodes greater than a key start
  *****************************************************************************/
-void list_node_swap( void *pvNodeA, void *pvNodeB )
+void *list_upper_bound( void *pvListEntry, const void *pvKey, list_cmp_t pfnCmp )
 {
-    node_head_t sTmp;
-    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
-    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
-    if( _IS_NODE(psHeadA) && _IS_NODE(psHeadB) ) {
-        sTmp = *psHeadA;
-        *psHeadA = *psHeadB;
-        *psHeadB = sTmp;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    if( !_IS_ENTRY(psList) || !pfnCmp ) {
+        return NULL;
     }
+    psHead = (void *)_skip_seek( psList, pvKey, pfnCmp, 0 )->m_psNext;
+    return (psHead != psList)?_TO_USER_ADDR(psHead):NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_node_first
- * @param [in]  pvListEntry  - List handle
- * @return      Pointer to the node or NULL if not founded
- * @brief       Get the node at the beginning of the specified list.
+ * @fn          list_compact
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnRelocate - Callback told of every move or NULL
+ * @return      true if compacted, false if failed
+ * @brief       Copy all nodes of a list into one block in list order so that
+ *              scans walk memory forward. Node addresses change, so pointers
+ *              kept outside must be updated from the callback, which runs
+ *              while the old node can still be read. Lists backed by a pool
+ *              are not compacted, and embedded links stay where they are.
  *****************************************************************************/
-void *list_node_first( void *pvListEntry )
+bool list_compact( void *pvListEntry, list_relocate_t pfnRelocate )
 {
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    return (_IS_ENTRY(psList)&&_HAS_NODE(psList))?_TO_USER_ADDR(psList->m_psNext):NULL;
+    if( !_IS_RW_ENTRY(psList) || _LIST_POOL(psList) ) {
+        return false;
+    }
+    return _compact_run( psList, (void *)psList->m_psNext, UINT32_MAX, pfnRelocate ) != NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_node_last
+ * @fn          list_compact_step
  * @param [in]  pvListEntry - List handle
- * @return      Pointer to the node or NULL if not founded
- * @brief       Get the node at the end of the specified list.
+ * @param [in]  pvFrom      - Node to start from, NULL for the first node
+ * @param [in]  uiNodes     - Maximum number of nodes to compact
+ * @param [in]  pfnRelocate - Callback told of every move or NULL
+ * @return      Node to start the next step from, or NULL when done or failed
+ * @brief       Compact a list a bounded number of nodes at a time, like
+ *              list_compact. Each step puts its nodes into a block of their
+ *              own. The returned node has not moved yet and must stay in the
+ *              list until the next step.
  *****************************************************************************/
-void *list_node_last( void *pvListEntry )
+void *list_compact_step( void *pvListEntry, void *pvFrom, uint32_t uiNodes, list_relocate_t pfnRelocate )
 {
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    return (_IS_ENTRY(psList)&&_HAS_NODE(psList))?_TO_USER_ADDR(psList->m_psPrev):NULL;
+    node_head_t *psHead = pvFrom?_TO_HEAD_ADDR(pvFrom):NULL;
+    if( !_IS_RW_ENTRY(psList) || _LIST_POOL(psList) || !uiNodes ) {
+        return NULL;
+    }
+    if( !psHead ) {
+        psHead = (void *)psList->m_psNext;
+    } else if( !_IS_USED_NODE(psHead) || psHead->m_psList != _OWNER(psList) ) {
+        return NULL;
+    }
+    psHead = _compact_run( psList, psHead, uiNodes, pfnRelocate );
+    return (psHead && psHead != psList)?_TO_USER_ADDR(psHead):NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_node_next
- * @param [in]  pvNode - Pointer to a node.
- * @return      Pointer to the the next node
- * @brief       Get next node or NULL if reach the end of list
+ * @fn          list_save
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  iFd         - File descriptor to write to, at its offset
+ * @return      true if saved, false if failed
+ * @brief       Write an image of a list for list_map. Nodes are laid out in
+ *              list order with their links already set for the address the
+ *              image prefers to be mapped at. Overlays such as the hash index
+ *              are not saved. The file must hold the image only.
  *****************************************************************************/
-void *list_node_next( void *pvNode )
+bool list_save( void *pvListEntry, int iFd )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
-    return _NOT_LAST_NODE(psHead)?_TO_USER_ADDR(psHead->m_psNext):NULL;
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    node_head_t *psHead;
+    map_head_t sMap;
+    list_ctrl_t sCtrl;
+    node_head_t sNode;
+    save_buf_t sBuf;
+    uint64_t ulOff = _MAP_NODE_OFF;
+    uint64_t ulLast = 0;
+    uint64_t ulNext;
+    uint32_t uiCount = 0;
+    if( !_IS_ENTRY(psList) || iFd < 0 ) {
+        return false;
+    }
+    /* Size the image first, links need to know where the last node goes */
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        ulLast = ulOff;
+        ulOff += _NODE_STRIDE(psHead->m_uiSize);
+        uiCount++;
+    }
+    memset( &sMap, 0, sizeof( sMap ) );
+    sMap.m_uiMagic = _MAP_MAGIC;
+    sMap.m_uiVersion = _MAP_VERSION;
+    sMap.m_uiHeadSize = _HEAD_SIZE;
+    sMap.m_uiPtrSize = sizeof( void * );
+    sMap.m_ulBase = _map_base( ulOff );
+    sMap.m_ulSize = ulOff;
+    memset( &sCtrl, 0, sizeof( sCtrl ) );
+    sCtrl.m_stEntry.m_psList = (void *)(uintptr_t)(sMap.m_ulBase + _MAP_ENTRY_OFF);
+    sCtrl.m_stEntry.m_psNext = (void *)(uintptr_t)(sMap.m_ulBase + (uiCount?_MAP_NODE_OFF:_MAP_ENTRY_OFF));
+    sCtrl.m_stEntry.m_psPrev = (void *)(uintptr_t)(sMap.m_ulBase + (uiCount?ulLast:_MAP_ENTRY_OFF));
+    sCtrl.m_stEntry.m_uiSize = uiCount;
+    sCtrl.m_stEntry.m_uiFlags = _NODE_F_ENTRY | _NODE_F_MAPPED;
+    sBuf.m_pBuf = malloc( _SAVE_BUF_SIZE );
+    sBuf.m_uiUsed = 0;
+    sBuf.m_iFd = iFd;
+    sBuf.m_bOk = (sBuf.m_pBuf != NULL);
+    _save_put( &sBuf, &sMap, sizeof( sMap ) );
+    _save_put( &sBuf, NULL, _MAP_ENTRY_OFF - sizeof( sMap ) );
+    _save_put( &sBuf, &sCtrl, sizeof( sCtrl ) );
+    _save_put( &sBuf, NULL, _MAP_NODE_OFF - _MAP_ENTRY_OFF - sizeof( sCtrl ) );
+    memset( &sNode, 0, sizeof( sNode ) );
+    sNode.m_psList = sCtrl.m_stEntry.m_psList;
+    sNode.m_psPrev = (void *)sCtrl.m_stEntry.m_psList;
+    sNode.m_uiFlags = _NODE_F_MAPPED;
+    ulOff = _MAP_NODE_OFF;
+    for( psHead = (void *)psList->m_psNext; psHead != psList && sBuf.m_bOk; psHead = (void *)psHead->m_psNext ) {
+        ulNext = ulOff + _NODE_STRIDE(psHead->m_uiSize);
+        sNode.m_psNext = (void *)(uintptr_t)(sMap.m_ulBase + ((ulOff == ulLast)?_MAP_ENTRY_OFF:ulNext));
+        sNode.m_uiSize = psHead->m_uiSize;
+        _save_put( &sBuf, &sNode, _HEAD_SIZE );
+        _save_put( &sBuf, _TO_USER_ADDR(psHead), psHead->m_uiSize );
+        _save_put( &sBuf, NULL, ulNext - ulOff - _HEAD_SIZE - psHead->m_uiSize );
+        sNode.m_psPrev = (void *)(uintptr_t)(sMap.m_ulBase + ulOff);
+        ulOff = ulNext;
+    }
+    _save_flush( &sBuf );
+    free( sBuf.m_pBuf );
+    return sBuf.m_bOk;
 }
 
 /**************************************************************************//**
- * @fn          list_node_prev
- * @param [in]  pvNode - Pointer to a node.
- * @return      Pointer to the the previous node
- * @brief       Get next node or NULL if reach the beginning of list
+ * @fn          list_map
+ * @param [in]  pcPath - Path of a file written by list_save
+ * @return      Handle of a read-only list or NULL if failed
+ * @brief       Map a list image. Every link is checked once, so a corrupted
+ *              or truncated file is refused. At its preferred address the
+ *              nodes are used right on the shared read-only pages. Elsewhere
+ *              the links are fixed up during the check on private pages.
+ *              Functions which would change the list do nothing on it, and
+ *              list_destroy unmaps it.
  *****************************************************************************/
-void *list_node_prev( void *pvNode )
+void *list_map( const char *pcPath )
 {
-    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
-    return _NOT_FIRST_NODE(psHead)?_TO_USER_ADDR(psHead->m_psPrev):NULL;
+    struct stat sStat;
+    map_head_t sMap;
+    void *pvMap = MAP_FAILED;
+    int iFd;
+    if( !pcPath || (iFd = open( pcPath, O_RDONLY | O_CLOEXEC )) < 0 ) {
+        return NULL;
+    }
+    if( fstat( iFd, &sStat ) < 0
+        || pread( iFd, &sMap, sizeof( sMap ), 0 ) != (ssize_t)sizeof( sMap )
+        || sMap.m_uiMagic != _MAP_MAGIC || sMap.m_uiVersion != _MAP_VERSION
+        || sMap.m_uiHeadSize != _HEAD_SIZE || sMap.m_uiPtrSize != sizeof( void * )
+        || sMap.m_ulSize != (uint64_t)sStat.st_size || sMap.m_ulSize < _MAP_NODE_OFF ) {
+        close( iFd );
+        return NULL;
+    }
+    if( sMap.m_ulBase ) {
+        pvMap = mmap( (void *)(uintptr_t)sMap.m_ulBase, sMap.m_ulSize, PROT_READ,
+                      MAP_PRIVATE | MAP_FIXED_NOREPLACE, iFd, 0 );
+        if( pvMap != MAP_FAILED && (pvMap != (void *)(uintptr_t)sMap.m_ulBase
+                                    || !_map_relocate( pvMap, &sMap )) ) {
+            munmap( pvMap, sMap.m_ulSize );
+            pvMap = MAP_FAILED;
+        }
+    }
+    if( pvMap == MAP_FAILED ) {
+        pvMap = mmap( NULL, sMap.m_ulSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, iFd, 0 );
+        if( pvMap != MAP_FAILED && (!_map_relocate( pvMap, &sMap )
+                                    || mprotect( pvMap, sMap.m_ulSize, PROT_READ ) < 0) ) {
+            munmap( pvMap, sMap.m_ulSize );
+            pvMap = MAP_FAILED;
+        }
+    }
+    close( iFd );
+    return (pvMap != MAP_FAILED)?_TO_USER_ADDR(pvMap + _MAP_ENTRY_OFF):NULL;
 }
 
 /**************************************************************************//**
- * @fn          list_length
+ * @fn          list_remove_if
  * @param [in]  pvListEntry - List handle
- * @return      The number of nodes in the list.
- * @brief       Get the number of nodes in a list.
+ * @param [in]  pfnPred     - Predicate telling which nodes to remove
+ * @param [in]  pvCtx       - User context passed to the predicate
+ * @return      The number of nodes removed
+ * @brief       Delete and free all nodes the predicate holds for in one walk.
+ *              The list is checked once. The nodes of a pool backed list are
+ *              chained up and go back to the pool all at once, and cached
+ *              nodes are chained up per size class and go to the cache
+ *              magazine by magazine. Embedded links are only deleted. The
+ *              predicate must not change the list.
  *****************************************************************************/
-uint32_t list_length( void *pvListEntry )
+uint32_t list_remove_if( void *pvListEntry, list_pred_t pfnPred, void *pvCtx )
 {
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    return _IS_ENTRY(psList)?psList->m_uiSize:0;
+    node_head_t *psHead;
+    node_head_t *psNext;
+    node_head_t sChain;
+    node_head_t *psTail = &sChain;
+    node_head_t *apsCached[_CACHE_CLASSES] = { NULL };
+    list_pool_t *psPool;
+    uint32_t uiCount = 0;
+    uint32_t i;
+    if( !_IS_RW_ENTRY(psList) || !pfnPred ) {
+        return 0;
+    }
+    psPool = _LIST_POOL(psList);
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = psNext ) {
+        psNext = (void *)psHead->m_psNext;
+        if( !pfnPred( _TO_USER_ADDR(psHead), pvCtx ) ) {
+            continue;
+        }
+        psHead->m_psPrev->m_stHead.m_psNext = (void *)psNext;
+        psNext->m_psPrev = psHead->m_psPrev;
+        _hook_unlink( psHead->m_psList, psHead );
+        psHead->m_psList = NULL;
+        uiCount++;
+        if( psPool ) {
+            psTail->m_psNext = (void *)psHead;
+            psTail = psHead;
+        } else if( !_IS_EXTERN(psHead) && _NODE_POOL(psHead)
+                   && _NODE_POOL(psHead)->m_uiKind == _POOL_CACHE ) {
+            i = _NODE_POOL(psHead) - s_astCacheClass;
+            psHead->m_psNext = (void *)apsCached[i];
+            apsCached[i] = psHead;
+        } else {
+            /* Still in cache, release it right away */
+            _node_release( psHead );
+        }
+    }
+    psList->m_uiSize -= uiCount;
+    if( psTail != &sChain ) {
+        psTail->m_psNext = (void *)psPool->m_psFree;
+        psPool->m_psFree = (void *)sChain.m_psNext;
+    }
+    for( i = 0; i < _CACHE_CLASSES; i++ ) {
+        if( apsCached[i] ) {
+            _cache_free_chain( i, apsCached[i] );
+        }
+    }
+    return uiCount;
+}
+
+/**************************************************************************//**
+ * @fn          list_clone
+ * @param [in]  pvListEntry - List handle
+ * @return      Handle of the new list or NULL if failed
+ * @brief       Copy a list with all of its nodes. The copies are laid out in
+ *              list order in one allocation, which goes back with the last
+ *              of them. The new list has the options of the old one but no
+ *              pool and no overlays. A mapped list gives a writable copy. A
+ *              list holding embedded links can not be cloned.
+ *****************************************************************************/
+void *list_clone( void *pvListEntry )
+{
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_entry_t *psCopy;
+    list_pool_t *psBlock;
+    node_head_t *psHead;
+    node_head_t *psNew;
+    node_head_t *psTail;
+    size_t ulSize = 0;
+    uint32_t uiCount = 0;
+    if( !_IS_ENTRY(psList) ) {
+        return NULL;
+    }
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        if( _IS_EXTERN(psHead) ) {
+            return NULL;
+        }
+        ulSize += _POOL_STRIDE((size_t)psHead->m_uiSize);
+        uiCount++;
+    }
+    pvListEntry = list_create_ex( NULL, (psList->m_uiFlags & _LIST_F_NO_OWNER)?LIST_OPT_NO_OWNER:0 );
+    if( !pvListEntry || !uiCount ) {
+        return pvListEntry;
+    }
+    psBlock = malloc( _BLOCK_HEAD_SIZE + ulSize );
+    if( !psBlock ) {
+        list_destroy( pvListEntry );
+        return NULL;
+    }
+    memset( psBlock, 0, sizeof( list_pool_t ) );
+    psBlock->m_uiChunkNodes = uiCount;
+    psBlock->m_uiKind = _POOL_BLOCK;
+    psCopy = _TO_HEAD_ADDR(pvListEntry);
+    psTail = psCopy;
+    psNew = (void *)psBlock + _BLOCK_HEAD_SIZE;
+    for( psHead = (void *)psList->m_psNext; psHead != psList; psHead = (void *)psHead->m_psNext ) {
+        memcpy( _TO_USER_ADDR(psNew), _TO_USER_ADDR(psHead), psHead->m_uiSize );
+        psNew->m_psList = _OWNER(psCopy);
+        _SET_POOL(psNew, psBlock);
+        psNew->m_uiSize = psHead->m_uiSize;
+        psNew->m_uiFlags = _NODE_F_POOLED;
+        psNew->m_psPrev = (void *)psTail;
+        psTail->m_psNext = (void *)psNew;
+        psTail = psNew;
+        _stats_link( psNew->m_psList, psNew );
+        psNew = (void *)psNew + _POOL_STRIDE(psNew->m_uiSize);
+    }
+    psTail->m_psNext = (void *)psCopy;
+    psCopy->m_psPrev = (void *)psTail;
+    psCopy->m_uiSize = uiCount;
+    return pvListEntry;
 }
 
 /**************************************************************************//**
@@ -323,19 +3554,38 @@ uint32_t list_length( void *pvListEntry )
  * @param [in]  pvListEntry - List handle
  * @return      None
  * @brief       Flush a list. All nodes in list will be deleted and freed
+ *              except embedded links, which are only deleted.
  *****************************************************************************/
 void list_flush( void *pvListEntry )
 {
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
     node_head_t *psHead;
-    if( _IS_ENTRY(psList) ) {
-        while( _HAS_NODE(psList) ) {
-            psHead = (void *)psList->m_psNext;
-            psHead->m_psNext->m_stHead.m_psPrev = (void *)psList;
-            psList->m_psNext = psHead->m_psNext;
-            psList->m_uiSize--;
-            free( psHead );
-        }
+    list_pool_t *psPool;
+    if( !_IS_RW_ENTRY(psList) ) {
+        return;
+    }
+    _stats_flush( psList );
+    if( _CTRL(psList)->m_psIndex ) {
+        _index_clear( _CTRL(psList)->m_psIndex );
+    }
+    if( _CTRL(psList)->m_psSkip ) {
+        _skip_clear( psList );
+    }
+    psPool = _LIST_POOL(psList);
+    if( psPool && _HAS_NODE(psList) ) {
+        /* Every node came from the pool, hand back the whole chain at once */
+        psList->m_psPrev->m_stHead.m_psNext = (void *)psPool->m_psFree;
+        psPool->m_psFree = (void *)psList->m_psNext;
+        psList->m_psNext = (void *)psList;
+        psList->m_psPrev = (void *)psList;
+        psList->m_uiSize = 0;
+    }
+    while( _HAS_NODE(psList) ) {
+        psHead = (void *)psList->m_psNext;
+        psHead->m_psNext->m_stHead.m_psPrev = (void *)psList;
+        psList->m_psNext = psHead->m_psNext;
+        psList->m_uiSize--;
+        _node_release( psHead );
     }
 }
 
@@ -348,17 +3598,156 @@ void list_flush( void *pvListEntry )
 void list_destroy( void *pvListEntry )
 {
     list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
-    node_head_t *psHead;
-    if( _IS_ENTRY(psList) ) {
-        while( _HAS_NODE(psList) ) {
-            psHead = (void *)psList->m_psNext;
-            psHead->m_psNext->m_stHead.m_psPrev = (void *)psList;
-            psList->m_psNext = psHead->m_psNext;
-            psList->m_uiSize--;
-            free( psHead );
+    if( _IS_ENTRY(psList) && _IS_MAPPED(psList) ) {
+        _map_release( psList );
+    } else if( _IS_ENTRY(psList) ) {
+        list_flush( pvListEntry );
+        list_index_destroy( pvListEntry );
+        list_skip_destroy( pvListEntry );
+        _stats_unregister( psList );
+        free( psList );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_stats_name
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pcName      - Name shown by list_stats_dump, cut to 31 chars
+ * @return      None
+ * @brief       Name a counted list. Characters which would need escaping in
+ *              JSON are replaced by '_'. Does nothing without LIST_CFG_STATS.
+ *****************************************************************************/
+void list_stats_name( void *pvListEntry, const char *pcName )
+{
+#ifdef LIST_CFG_STATS
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    char acName[_STATS_NAME_SIZE];
+    uint32_t i;
+    if( !_IS_ENTRY(psList) || !_HAS_STATS(psList) || !pcName ) {
+        return;
+    }
+    for( i = 0; i < _STATS_NAME_SIZE - 1 && pcName[i]; i++ ) {
+        acName[i] = (pcName[i] < 0x20 || pcName[i] > 0x7e || pcName[i] == '"'
+                     || pcName[i] == '\\')?'_':pcName[i];
+    }
+    acName[i] = '\0';
+    pthread_mutex_lock( &s_sStatsLock );
+    memcpy( _REC(psList)->m_acName, acName, i + 1 );
+    pthread_mutex_unlock( &s_sStatsLock );
+#else
+    (void)pvListEntry;
+    (void)pcName;
+#endif
+}
+
+/**************************************************************************//**
+ * @fn          list_stats_get
+ * @param [in]  pvListEntry - List handle
+ * @param [out] psStats     - Counters of the list
+ * @return      true if the list is counted
+ * @brief       Read the counters of a list. Each counter is read on its own,
+ *              so they may disagree a little while other threads change
+ *              the list.
+ *****************************************************************************/
+bool list_stats_get( void *pvListEntry, list_stats_t *psStats )
+{
+#ifdef LIST_CFG_STATS
+    list_entry_t *psList = _TO_HEAD_ADDR(pvListEntry);
+    list_stats_t *psSrc;
+    uint32_t i;
+    if( !_IS_ENTRY(psList) || !_HAS_STATS(psList) || !psStats ) {
+        return false;
+    }
+    psSrc = &_REC(psList)->m_stStats;
+    psStats->m_ulInserts = __atomic_load_n( &psSrc->m_ulInserts, __ATOMIC_RELAXED );
+    psStats->m_ulDeletes = __atomic_load_n( &psSrc->m_ulDeletes, __ATOMIC_RELAXED );
+    psStats->m_ulNext = __atomic_load_n( &psSrc->m_ulNext, __ATOMIC_RELAXED );
+    psStats->m_ulPrev = __atomic_load_n( &psSrc->m_ulPrev, __ATOMIC_RELAXED );
+    psStats->m_ulBytesIn = __atomic_load_n( &psSrc->m_ulBytesIn, __ATOMIC_RELAXED );
+    psStats->m_ulBytesOut = __atomic_load_n( &psSrc->m_ulBytesOut, __ATOMIC_RELAXED );
+    psStats->m_ulPeak = __atomic_load_n( &psSrc->m_ulPeak, __ATOMIC_RELAXED );
+    for( i = 0; i < LIST_STATS_BUCKETS; i++ ) {
+        psStats->m_aulSizeHist[i] = __atomic_load_n( &psSrc->m_aulSizeHist[i], __ATOMIC_RELAXED );
+    }
+    return true;
+#else
+    (void)pvListEntry;
+    (void)psStats;
+    return false;
+#endif
+}
+
+/**************************************************************************//**
+ * @fn          list_stats_for_each
+ * @param [in]  pfnVisit - Visitor called with the handle of every counted list
+ * @param [in]  pvCtx    - User context passed to the visitor
+ * @return      None
+ * @brief       Walk the registry of counted lists, in order of creation. The
+ *              registry is locked during the walk, so the visitor must not
+ *              create or destroy a list. A nonzero return stops the walk.
+ *****************************************************************************/
+void list_stats_for_each( list_visit_t pfnVisit, void *pvCtx )
+{
+#ifdef LIST_CFG_STATS
+    stats_rec_t *psRec;
+    if( !pfnVisit ) {
+        return;
+    }
+    pthread_mutex_lock( &s_sStatsLock );
+    for( psRec = s_stStatsReg.m_psNext; psRec != &s_stStatsReg; psRec = psRec->m_psNext ) {
+        if( pfnVisit( _TO_USER_ADDR(_stats_entry( psRec )), pvCtx ) ) {
+            break;
         }
     }
-    free( psList );
+    pthread_mutex_unlock( &s_sStatsLock );
+#else
+    (void)pfnVisit;
+    (void)pvCtx;
+#endif
+}
+
+/**************************************************************************//**
+ * @fn          list_stats_dump
+ * @param [in]  iFd - File descriptor open for writing
+ * @return      true if the whole report is written
+ * @brief       Write the counters of all counted lists to a file as one JSON
+ *              object, one list per line. Besides the counters each list
+ *              reports its length, the bytes of its live nodes and how many
+ *              of them are node heads. Without LIST_CFG_STATS the report is
+ *              {"enabled":false,"lists":[]}.
+ *****************************************************************************/
+bool list_stats_dump( int iFd )
+{
+    save_buf_t sBuf;
+    char acLine[_STATS_LINE_SIZE];
+    int iLen;
+#ifdef LIST_CFG_STATS
+    stats_rec_t *psRec;
+#endif
+    sBuf.m_pBuf = malloc( _SAVE_BUF_SIZE );
+    if( !sBuf.m_pBuf ) {
+        return false;
+    }
+    sBuf.m_uiUsed = 0;
+    sBuf.m_iFd = iFd;
+    sBuf.m_bOk = true;
+#ifdef LIST_CFG_STATS
+    iLen = snprintf( acLine, sizeof( acLine ), "{\"enabled\":true,\"head_size\":%u,\"lists\":[",
+                     (uint32_t)_HEAD_SIZE );
+    _save_put( &sBuf, acLine, iLen );
+    pthread_mutex_lock( &s_sStatsLock );
+    for( psRec = s_stStatsReg.m_psNext; psRec != &s_stStatsReg; psRec = psRec->m_psNext ) {
+        _stats_emit( &sBuf, psRec, psRec != s_stStatsReg.m_psNext );
+    }
+    pthread_mutex_unlock( &s_sStatsLock );
+    _save_put( &sBuf, "\n]}\n", 4 );
+#else
+    iLen = snprintf( acLine, sizeof( acLine ), "{\"enabled\":false,\"lists\":[]}\n" );
+    _save_put( &sBuf, acLine, iLen );
+#endif
+    _save_flush( &sBuf );
+    free( sBuf.m_pBuf );
+    return sBuf.m_bOk;
 }
 
 /******************************************************************************
@@ -44,6 +44,88 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _NODE_HEAD_T node_head_t;
+
+/* Head in front of the user data field of every node. It can also be embedded
+ * in a user struct as an intrusive link, see list_link_init. Its size is a
+ * multiple of 16 bytes on 64-bit targets, so the user data field keeps the
+ * alignment of malloc. */
+struct _NODE_HEAD_T {
+    struct _LIST_NODE_T *m_psNext;
+    struct _LIST_NODE_T *m_psPrev;
+    struct _NODE_HEAD_T *m_psList;
+    uint32_t m_uiSize;
+    uint32_t m_uiFlags;
+};
+
+/* Compare function on the user data fields of two nodes, returns a negative,
+ * zero or positive value like the one of qsort */
+typedef int (*list_cmp_t)( const void *pvNodeA, const void *pvNodeB );
+
+/* Functions of a hash index: the key within the user data field of a node,
+ * the hash of a key and the equality of two keys */
+typedef const void *(*list_key_t)( const void *pvNode );
+typedef uint32_t (*list_hash_t)( const void *pvKey );
+typedef bool (*list_eq_t)( const void *pvKeyA, const void *pvKeyB );
+
+/* Visitors of list_for_each and list_for_each_batch, return non-zero to
+ * stop the walk */
+typedef int (*list_visit_t)( void *pvNode, void *pvCtx );
+typedef int (*list_batch_t)( void **ppvNodes, uint32_t uiCount, void *pvCtx );
+
+/* Predicate of list_remove_if, returns true for a node to be removed */
+typedef bool (*list_pred_t)( const void *pvNode, void *pvCtx );
+
+/* Told the old and the new address of a node moved by list_compact */
+typedef void (*list_relocate_t)( void *pvOld, void *pvNew );
+
+/* Number of payload size buckets of list_stats_t */
+#define LIST_STATS_BUCKETS          (16)
+
+typedef struct _LIST_STATS_T list_stats_t;
+
+/* Counters kept for every list by a library built with LIST_CFG_STATS. The
+ * nodes leaving a list include those freed by list_flush, bytes count the
+ * head and the user data field of a node. Steps are counted once per walk,
+ * single steps of list_node_next and list_node_prev are not counted so that
+ * they stay free of writes to shared counters. */
+struct _LIST_STATS_T {
+    uint64_t m_ulInserts;       /* Nodes which joined the list */
+    uint64_t m_ulDeletes;       /* Nodes which left the list */
+    uint64_t m_ulNext;          /* Steps of list_for_each and list_for_each_batch */
+    uint64_t m_ulPrev;          /* Steps of list_for_each_reverse */
+    uint64_t m_ulBytesIn;       /* Bytes of the nodes which joined */
+    uint64_t m_ulBytesOut;      /* Bytes of the nodes which left */
+    uint64_t m_ulPeak;          /* Highest length reached */
+    /* Joined nodes by user data size, bucket i holds sizes up to 8 << i and
+     * the last bucket all larger ones */
+    uint64_t m_aulSizeHist[LIST_STATS_BUCKETS];
+};
+
+/* Macro Definitions ------------------------------------------------------- */
+
+/* Options of list_create_ex. With LIST_OPT_NO_OWNER the nodes do not record
+ * which list they are in, so moving them between such lists is O(1), while
+ * list_length has to walk the list. */
+#define LIST_OPT_NO_OWNER           (0x00000001u)
+
+/* Returned by list_node_index for a node not in any list */
+#define LIST_INDEX_NONE             (0xFFFFFFFFu)
+
+/* Convert between an embedded link and the node standing for it */
+#define LIST_LINK_TO_NODE(psLink)   ((void *)((node_head_t *)(psLink) + 1))
+#define LIST_NODE_TO_LINK(pvNode)   ((node_head_t *)(pvNode) - 1)
+
+/* Get the user struct which embeds the link of the given node */
+#define LIST_CONTAINER_OF(pvNode, type, member) \
+    ((type *)((char *)LIST_NODE_TO_LINK(pvNode) - offsetof(type, member)))
+
 /* External Interfaces ----------------------------------------------------- */
 
 /**************************************************************************//**
@@ -54,6 +136,54 @@
  *****************************************************************************/
 void *list_create( void );
 
+/**************************************************************************//**
+ * @fn          list_create_from
+ * @param [in]  pvPool - Pool handle
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list backed by a node pool. Only nodes
+ *              carved from this pool can be added to the list, which lets
+ *              list_flush and list_destroy release all nodes in one step.
+ *****************************************************************************/
+void *list_create_from( void *pvPool );
+
+/**************************************************************************//**
+ * @fn          list_create_ex
+ * @param [in]  pvPool    - Pool handle or NULL for a list not backed by a pool
+ * @param [in]  uiOptions - LIST_OPT_xxx flags
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty list with options. A list with
+ *              LIST_OPT_NO_OWNER can not be backed by a pool.
+ *****************************************************************************/
+void *list_create_ex( void *pvPool, uint32_t uiOptions );
+
+/**************************************************************************//**
+ * @fn          list_pool_create
+ * @param [in]  uiNodeSize   - Size of user data field of every node
+ * @param [in]  uiChunkNodes - Number of nodes carved from one chunk
+ * @return      Handle of the created pool or NULL if failed
+ * @brief       Create a node pool. Nodes are carved from large chunks and
+ *              recycled through a free list instead of malloc and free.
+ *****************************************************************************/
+void *list_pool_create( uint32_t uiNodeSize, uint32_t uiChunkNodes );
+
+/**************************************************************************//**
+ * @fn          list_pool_destroy
+ * @param [in]  pvPool - Pool handle
+ * @return      None
+ * @brief       Free a pool including all chunks. Every node carved from the
+ *              pool becomes invalid, so no list may still hold one of them.
+ *****************************************************************************/
+void list_pool_destroy( void *pvPool );
+
+/**************************************************************************//**
+ * @fn          list_node_alloc_from
+ * @param [in]  pvPool - Pool handle
+ * @return      Pointer to the created node or NULL if failed
+ * @brief       Take a node from a pool. The size of user data field is the
+ *              node size given when the pool was created.
+ *****************************************************************************/
+void *list_node_alloc_from( void *pvPool );
+
 /**************************************************************************//**
  * @fn          list_node_alloc
  * @param [in]  uiSize - Expected size of user data field
@@ -62,14 +192,51 @@ void *list_create( void );
  *****************************************************************************/
 void *list_node_alloc( uint32_t uiSize );
 
+/**************************************************************************//**
+ * @fn          list_alloc_batch
+ * @param [in]  uiSize   - Expected size of user data field of every node
+ * @param [in]  uiNodes  - Number of nodes
+ * @param [out] ppvNodes - Array receiving the created nodes
+ * @return      true if created, false if failed
+ * @brief       Create a number of nodes out of one allocation. The nodes are
+ *              laid out in array order and are freed one by one as usual,
+ *              the memory goes back with the last of them.
+ *****************************************************************************/
+bool list_alloc_batch( uint32_t uiSize, uint32_t uiNodes, void **ppvNodes );
+
+/**************************************************************************//**
+ * @fn          list_node_cache_enable
+ * @param [in]  bEnable - true to serve list_node_alloc from the node cache
+ * @return      None
+ * @brief       Switch the node cache of list_node_alloc on or off. With the
+ *              cache on, nodes up to 4 KB are rounded up to a power of two
+ *              size class and recycled through per-thread magazines, which
+ *              are traded in batches with a shared depot of bounded size.
+ *              A node always goes back to where it came from, so the switch
+ *              may be flipped at any time.
+ *****************************************************************************/
+void list_node_cache_enable( bool bEnable );
+
 /**************************************************************************//**
  * @fn          list_node_free
  * @param [in]  pvNode - Pointer to a node
  * @return      None
- * @brief       Free the memory of the given node
+ * @brief       Free the memory of the given node. A pooled node goes back to
+ *              its pool and an embedded link is left untouched.
  *****************************************************************************/
 void list_node_free( void *pvNode );
 
+/**************************************************************************//**
+ * @fn          list_link_init
+ * @param [in]  psLink - Pointer to a link embedded in a user struct
+ * @return      Pointer to the node standing for the link or NULL if failed
+ * @brief       Prepare an embedded link to be used as an idle node. The node
+ *              works with all link and iteration functions but its memory
+ *              belongs to the caller, so list_node_free, list_flush and
+ *              list_destroy never free it.
+ *****************************************************************************/
+void *list_link_init( node_head_t *psLink );
+
 /**************************************************************************//**
  * @fn          list_node_size
  * @param [in]  pvNode - Pointer to a node.
@@ -78,6 +245,24 @@ void list_node_free( void *pvNode );
  *****************************************************************************/
 uint32_t list_node_size( void *pvNode );
 
+/**************************************************************************//**
+ * @fn          list_node_resize
+ * @param [in]  pvNode - Pointer to a node
+ * @param [in]  uiSize - New size of user data field
+ * @return      Pointer to the node, which may have moved, or NULL if failed
+ * @brief       Change the size of user data field of a node, keeping its
+ *              place in a list and the data up to the smaller size. A node
+ *              stays where it is if its memory is large enough: a node of
+ *              list_node_alloc is grown by realloc, a node of the node cache
+ *              up to its size class and a pooled node up to the node size of
+ *              the pool. Otherwise it moves to a node of list_node_alloc,
+ *              which is not possible in a pool backed list. Nodes of a list
+ *              with an index or a skip list are moved rather than realloced
+ *              so that the overlays can follow. On failure the node is left
+ *              as it was. Embedded links can not be resized.
+ *****************************************************************************/
+void *list_node_resize( void *pvNode, uint32_t uiSize );
+
 /**************************************************************************//**
  * @fn          list_add_rear
  * @param [in]  pvListEntry - List handle
@@ -96,6 +281,19 @@ void list_add_rear( void *pvListEntry, void *pvNode );
  *****************************************************************************/
 void list_add_front( void *pvListEntry, void *pvNode );
 
+/**************************************************************************//**
+ * @fn          list_add_rear_batch
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  ppvNodes    - Array of nodes
+ * @param [in]  uiNodes     - Number of nodes in the array
+ * @return      The number of nodes added
+ * @brief       Add nodes at the end of a list in array order. The list is
+ *              checked once and the nodes are chained up before being hung
+ *              into the list in one step. Nodes which list_add_rear would
+ *              refuse are skipped.
+ *****************************************************************************/
+uint32_t list_add_rear_batch( void *pvListEntry, void **ppvNodes, uint32_t uiNodes );
+
 /**************************************************************************//**
  * @fn          list_insert_before
  * @param [in]  pvNodeA - Pointer to a node.
@@ -131,6 +329,49 @@ void list_node_del( void *pvNode );
  *****************************************************************************/
 void list_node_swap( void *pvNodeA, void *pvNodeB );
 
+/**************************************************************************//**
+ * @fn          list_splice
+ * @param [in]  pvListEntry - List handle of the destination
+ * @param [in]  pvPos       - Node of the destination to put the range before,
+ *                            NULL to put it at the end. It must not be in
+ *                            the range.
+ * @param [in]  pvFirst     - First node of the range
+ * @param [in]  pvLast      - Last node of the range, in the same list and not
+ *                            before pvFirst
+ * @return      None
+ * @brief       Move a range of nodes into a list. The chain is relinked at
+ *              its ends in constant time. The nodes are walked once only when
+ *              they have to record a new owner, that is when moving between
+ *              two different lists not created with LIST_OPT_NO_OWNER. The
+ *              range is not walked to check the arguments, so the caller
+ *              must keep pvPos out of the range and pvLast behind pvFirst,
+ *              and for lists created with LIST_OPT_NO_OWNER, which do not
+ *              know their nodes, keep pvPos in the destination.
+ *****************************************************************************/
+void list_splice( void *pvListEntry, void *pvPos, void *pvFirst, void *pvLast );
+
+/**************************************************************************//**
+ * @fn          list_concat
+ * @param [in]  pvListEntry - List handle of the destination
+ * @param [in]  pvSource    - List handle of the source
+ * @return      None
+ * @brief       Move all nodes of a list to the end of another list. See
+ *              list_splice for the cost.
+ *****************************************************************************/
+void list_concat( void *pvListEntry, void *pvSource );
+
+/**************************************************************************//**
+ * @fn          list_split_after
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node of the list
+ * @return      Handle of a new list holding the nodes after the given node
+ *              or NULL if failed
+ * @brief       Split a list in two after a node. The new list has the same
+ *              pool and options as the given one. See list_splice for the
+ *              cost.
+ *****************************************************************************/
+void *list_split_after( void *pvListEntry, void *pvNode );
+
 /**************************************************************************//**
  * @fn          list_node_first
  * @param [in]  pvListEntry  - List handle
@@ -163,19 +404,291 @@ void *list_node_next( void *pvNode );
  *****************************************************************************/
 void *list_node_prev( void *pvNode );
 
+/**************************************************************************//**
+ * @fn          list_for_each
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every node in order
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list. The list is checked once instead of
+ *              on every step, and nodes are prefetched a few steps ahead of
+ *              the visitor. The visitor may delete or free the node it is
+ *              given but no other node.
+ *****************************************************************************/
+void list_for_each( void *pvListEntry, list_visit_t pfnVisit, void *pvCtx );
+
+/**************************************************************************//**
+ * @fn          list_for_each_reverse
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every node from the end
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list backwards, like list_for_each
+ *****************************************************************************/
+void list_for_each_reverse( void *pvListEntry, list_visit_t pfnVisit, void *pvCtx );
+
+/**************************************************************************//**
+ * @fn          list_for_each_batch
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnVisit    - Visitor called on every batch of nodes in order
+ * @param [in]  pvCtx       - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all nodes of a list, handing them to the visitor up to
+ *              16 at a time. The chain is followed and the user data fields
+ *              are prefetched while a batch is gathered, so the visitor
+ *              works on data already on its way. The visitor may delete or
+ *              free the nodes of its batch but no other node.
+ *****************************************************************************/
+void list_for_each_batch( void *pvListEntry, list_batch_t pfnVisit, void *pvCtx );
+
 /**************************************************************************//**
  * @fn          list_length
  * @param [in]  pvListEntry - List handle
  * @return      The number of nodes in the list.
- * @brief       Get the number of nodes in a list.
+ * @brief       Get the number of nodes in a list. It takes a walk on a list
+ *              created with LIST_OPT_NO_OWNER.
  *****************************************************************************/
 uint32_t list_length( void *pvListEntry );
 
+/**************************************************************************//**
+ * @fn          list_sort
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnCmp      - Compare function on user data fields
+ * @return      None
+ * @brief       Sort a list in place with a stable bottom-up merge sort. The
+ *              nodes are relinked, nothing is allocated or copied.
+ *****************************************************************************/
+void list_sort( void *pvListEntry, list_cmp_t pfnCmp );
+
+/**************************************************************************//**
+ * @fn          list_sort_parallel
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnCmp      - Compare function on user data fields
+ * @param [in]  uiThreads   - Number of threads to use
+ * @return      None
+ * @brief       Sort a list like list_sort using several threads. The chain
+ *              is cut into one run per thread, the runs are sorted in
+ *              parallel and then merged pairwise, also in parallel. The
+ *              compare function must be safe to call from several threads.
+ *****************************************************************************/
+void list_sort_parallel( void *pvListEntry, list_cmp_t pfnCmp, uint32_t uiThreads );
+
+/**************************************************************************//**
+ * @fn          list_index_create
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnKey      - Function giving the key within a user data field
+ * @param [in]  pfnHash     - Hash function on keys
+ * @param [in]  pfnEq       - Equality function on keys
+ * @return      true if created, false if failed
+ * @brief       Attach a hash index to a list for list_find. The index follows
+ *              every add, insert, delete, move and flush of the list. A list
+ *              has at most one index and a new one replaces the old one. A
+ *              list created with LIST_OPT_NO_OWNER can not be indexed.
+ *****************************************************************************/
+bool list_index_create( void *pvListEntry, list_key_t pfnKey, list_hash_t pfnHash, list_eq_t pfnEq );
+
+/**************************************************************************//**
+ * @fn          list_index_destroy
+ * @param [in]  pvListEntry - List handle
+ * @return      None
+ * @brief       Detach and free the hash index of a list if any
+ *****************************************************************************/
+void list_index_destroy( void *pvListEntry );
+
+/**************************************************************************//**
+ * @fn          list_index_reserve
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  uiNodes     - Number of nodes to make room for
+ * @return      true if done, false if there is no index or out of memory
+ * @brief       Grow the hash index of a list once so that it holds the given
+ *              number of nodes without growing again
+ *****************************************************************************/
+bool list_index_reserve( void *pvListEntry, uint32_t uiNodes );
+
+/**************************************************************************//**
+ * @fn          list_reserve
+ * @param [in]  pvListEntry - Handle of a list created by list_create_from
+ * @param [in]  uiNodes     - Number of nodes to make room for
+ * @return      true if done, false if the list has no pool or out of memory
+ * @brief       Make room for more nodes in a pool backed list with one
+ *              allocation. The nodes are carved into the pool and the slots
+ *              of the hash index, if any, are placed behind them, so that
+ *              neither grows again until the list holds more. The slots
+ *              belong to the pool then, which must outlive the index.
+ *****************************************************************************/
+bool list_reserve( void *pvListEntry, uint32_t uiNodes );
+
+/**************************************************************************//**
+ * @fn          list_find
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvKey       - Pointer to the key to look for
+ * @return      Pointer to a node with the key or NULL if not founded
+ * @brief       Find a node by key through the hash index of a list in O(1)
+ *              on average. The node must not be changed in its key while it
+ *              is in an indexed list.
+ *****************************************************************************/
+void *list_find( void *pvListEntry, const void *pvKey );
+
+/**************************************************************************//**
+ * @fn          list_skip_create
+ * @param [in]  pvListEntry - List handle
+ * @return      true if created, false if failed
+ * @brief       Attach an order statistic skip list to a list, which makes
+ *              list_node_at and list_node_index O(log n) on average. It is
+ *              kept up by every add, insert, delete and swap. After a sort,
+ *              splice, concat or split it is rebuilt in O(n) on next use.
+ *              A list created with LIST_OPT_NO_OWNER can not have one.
+ *****************************************************************************/
+bool list_skip_create( void *pvListEntry );
+
+/**************************************************************************//**
+ * @fn          list_skip_destroy
+ * @param [in]  pvListEntry - List handle
+ * @return      None
+ * @brief       Detach and free the skip list of a list if any
+ *****************************************************************************/
+void list_skip_destroy( void *pvListEntry );
+
+/**************************************************************************//**
+ * @fn          list_node_at
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  uiIndex     - Position of the node from 0
+ * @return      Pointer to the node or NULL if out of range
+ * @brief       Get the node at a position, in O(log n) with a skip list and
+ *              by walking the list otherwise
+ *****************************************************************************/
+void *list_node_at( void *pvListEntry, uint32_t uiIndex );
+
+/**************************************************************************//**
+ * @fn          list_node_index
+ * @param [in]  pvNode - Pointer to a node
+ * @return      Position of the node from 0 or LIST_INDEX_NONE if not in list
+ * @brief       Get the position of a node in its list, in O(log n) with a
+ *              skip list and by walking the list otherwise
+ *****************************************************************************/
+uint32_t list_node_index( void *pvNode );
+
+/**************************************************************************//**
+ * @fn          list_insert_sorted
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to an idle node
+ * @param [in]  pfnCmp      - Compare function on user data fields
+ * @return      None
+ * @brief       Insert a node into a list kept in order, after the nodes equal
+ *              to it. A skip list is attached on first use, so inserts and
+ *              bounds are O(log n) on average. The list stays in order as
+ *              long as nodes are only added by this function.
+ *****************************************************************************/
+void list_insert_sorted( void *pvListEntry, void *pvNode, list_cmp_t pfnCmp );
+
+/**************************************************************************//**
+ * @fn          list_lower_bound
+ * @param [in]  pvListEntry - List handle of a sorted list
+ * @param [in]  pvKey       - Key to look for
+ * @param [in]  pfnCmp      - Compare function called with the key and a user
+ *                            data field, like the one of bsearch
+ * @return      Pointer to the first node not less than the key or NULL
+ * @brief       Find where the nodes not less than a key start. A range is
+ *              scanned with list_node_next from the lower bound of its start
+ *              up to the upper bound of its end.
+ *****************************************************************************/
+void *list_lower_bound( void *pvListEntry, const void *pvKey, list_cmp_t pfnCmp );
+
+/**************************************************************************//**
+ * @fn          list_upper_bound
+ * @param [in]  pvListEntry - List handle of a sorted list
+ * @param [in]  pvKey       - Key to look for
+ * @param [in]  pfnCmp      - Compare function called with the key and a user
+ *                            data field, like the one of bsearch
+ * @return      Pointer to the first node greater than the key or NULL
+ * @brief       Find where the nodes greater than a key start
+ *****************************************************************************/
+void *list_upper_bound( void *pvListEntry, const void *pvKey, list_cmp_t pfnCmp );
+
+/**************************************************************************//**
+ * @fn          list_compact
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnRelocate - Callback told of every move or NULL
+ * @return      true if compacted, false if failed
+ * @brief       Copy all nodes of a list into one block in list order so that
+ *              scans walk memory forward. Node addresses change, so pointers
+ *              kept outside must be updated from the callback, which runs
+ *              while the old node can still be read. Lists backed by a pool
+ *              are not compacted, and embedded links stay where they are.
+ *****************************************************************************/
+bool list_compact( void *pvListEntry, list_relocate_t pfnRelocate );
+
+/**************************************************************************//**
+ * @fn          list_compact_step
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvFrom      - Node to start from, NULL for the first node
+ * @param [in]  uiNodes     - Maximum number of nodes to compact
+ * @param [in]  pfnRelocate - Callback told of every move or NULL
+ * @return      Node to start the next step from, or NULL when done or failed
+ * @brief       Compact a list a bounded number of nodes at a time, like
+ *              list_compact. Each step puts its nodes into a block of their
+ *              own. The returned node has not moved yet and must stay in the
+ *              list until the next step.
+ *****************************************************************************/
+void *list_compact_step( void *pvListEntry, void *pvFrom, uint32_t uiNodes, list_relocate_t pfnRelocate );
+
+/**************************************************************************//**
+ * @fn          list_save
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  iFd         - File descriptor to write to, at its offset
+ * @return      true if saved, false if failed
+ * @brief       Write an image of a list for list_map. Nodes are laid out in
+ *              list order with their links already set for the address the
+ *              image prefers to be mapped at. Overlays such as the hash index
+ *              are not saved. The file must hold the image only.
+ *****************************************************************************/
+bool list_save( void *pvListEntry, int iFd );
+
+/**************************************************************************//**
+ * @fn          list_map
+ * @param [in]  pcPath - Path of a file written by list_save
+ * @return      Handle of a read-only list or NULL if failed
+ * @brief       Map a list image. Every link is checked once, so a corrupted
+ *              or truncated file is refused. At its preferred address the
+ *              nodes are used right on the shared read-only pages. Elsewhere
+ *              the links are fixed up during the check on private pages.
+ *              Functions which would change the list do nothing on it, and
+ *              list_destroy unmaps it.
+ *****************************************************************************/
+void *list_map( const char *pcPath );
+
+/**************************************************************************//**
+ * @fn          list_remove_if
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pfnPred     - Predicate telling which nodes to remove
+ * @param [in]  pvCtx       - User context passed to the predicate
+ * @return      The number of nodes removed
+ * @brief       Delete and free all nodes the predicate holds for in one walk.
+ *              The list is checked once, and the nodes of a pool backed list
+ *              are chained up and go back to the pool all at once. Embedded
+ *              links are only deleted. The predicate must not change the
+ *              list.
+ *****************************************************************************/
+uint32_t list_remove_if( void *pvListEntry, list_pred_t pfnPred, void *pvCtx );
+
+/**************************************************************************//**
+ * @fn          list_clone
+ * @param [in]  pvListEntry - List handle
+ * @return      Handle of the new list or NULL if failed
+ * @brief       Copy a list with all of its nodes. The copies are laid out in
+ *              list order in one allocation, which goes back with the last
+ *              of them. The new list has the options of the old one but no
+ *              pool and no overlays. A mapped list gives a writable copy. A
+ *              list holding embedded links can not be cloned.
+ *****************************************************************************/
+void *list_clone( void *pvListEntry );
+
 /**************************************************************************//**
  * @fn          list_flush
  * @param [in]  pvListEntry - List handle
  * @return      None
  * @brief       Flush a list. All nodes in list will be deleted and freed
+ *              except embedded links, which are only deleted.
  *****************************************************************************/
 void list_flush( void *pvListEntry );
 
@@ -187,6 +700,59 @@ void list_flush( void *pvListEntry );
  *****************************************************************************/
 void list_destroy( void *pvListEntry );
 
+/**************************************************************************//**
+ * @fn          list_stats_name
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pcName      - Name shown by list_stats_dump, cut to 31 chars
+ * @return      None
+ * @brief       Name a counted list. Characters which would need escaping in
+ *              JSON are replaced by '_'. Does nothing without LIST_CFG_STATS.
+ *****************************************************************************/
+void list_stats_name( void *pvListEntry, const char *pcName );
+
+/**************************************************************************//**
+ * @fn          list_stats_get
+ * @param [in]  pvListEntry - List handle
+ * @param [out] psStats     - Counters of the list
+ * @return      true if the list is counted
+ * @brief       Read the counters of a list. Each counter is read on its own,
+ *              so they may disagree a little while other threads change
+ *              the list.
+ *****************************************************************************/
+bool list_stats_get( void *pvListEntry, list_stats_t *psStats );
+
+/**************************************************************************//**
+ * @fn          list_stats_for_each
+ * @param [in]  pfnVisit - Visitor called with the handle of every counted list
+ * @param [in]  pvCtx    - User context passed to the visitor
+ * @return      None
+ * @brief       Walk the registry of counted lists, in order of creation. The
+ *              registry is locked during the walk, so the visitor must not
+ *              create or destroy a list. A nonzero return stops the walk.
+ *****************************************************************************/
+void list_stats_for_each( list_visit_t pfnVisit, void *pvCtx );
+
+/**************************************************************************//**
+ * @fn          list_stats_dump
+ * @param [in]  iFd - File descriptor open for writing
+ * @return      true if the whole report is written
+ * @brief       Write the counters of all counted lists to a file as one JSON
+ *              object, one list per line. Besides the counters each list
+ *              reports its length, the bytes of its live nodes and how many
+ *              of them are node heads. Without LIST_CFG_STATS the report is
+ *              {"enabled":false,"lists":[]}.
+ *****************************************************************************/
+bool list_stats_dump( int iFd );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Inline versions of the hot functions, see list_inline.h */
+#ifdef LIST_CFG_INLINE
+#include "list_inline.h"
+#endif
+
 #endif /* _LIST_H_ */
 /******************************************************************************
  *                              End of File
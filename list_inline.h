@@ -0,0 +1,328 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        list_inline.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Inline versions of the hot list functions
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *
+ * Included by list.h when LIST_CFG_INLINE is defined, in C and in C++. The
+ * functions below then replace the ones of list.c at compile time, so loops
+ * over a list compile down to pointer chasing. Only the per-node calls of a
+ * loop are inlined: list_node_first, list_node_last, list_node_next,
+ * list_node_prev, list_node_size, list_length, list_add_rear, list_add_front,
+ * list_insert_before, ilst_insert_after and list_node_del. The others, such
+ * as list_for_each, list_sort or list_splice, already do their work in one
+ * call and stay in list.c. Changes to a list with a hash index or a skip
+ * list, to a list created with LIST_OPT_NO_OWNER, to a mapped list or to a
+ * list counted by a library built with LIST_CFG_STATS still go through
+ * list.c. With LIST_CFG_UNCHECKED also defined, the handle and node state
+ * checks are left out as well, so a bad handle or a misused node is no longer
+ * ignored but undefined behavior. The switches are for the users of the
+ * library, its own sources are built without them.
+ *****************************************************************************/
+
+#ifndef _LIST_INLINE_H_
+#define _LIST_INLINE_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include "list_priv.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#ifdef LIST_CFG_UNCHECKED
+#define _LIST_CHECK(c)      (1)
+#define _LIST_HEAD(p)       (LIST_NODE_TO_LINK(p))
+#else
+#define _LIST_CHECK(c)      (c)
+#define _LIST_HEAD(p)       ((p)?LIST_NODE_TO_LINK(p):(node_head_t *)NULL)
+#endif
+
+/* Plain casts only, so that C++ can take the functions as well */
+#define _LIST_USER(p)       (LIST_LINK_TO_NODE(p))
+#define _LIST_LINK(p)       ((struct _LIST_NODE_T *)(void *)(p))
+#define _LIST_NEXT(p)       ((node_head_t *)(void *)(p)->m_psNext)
+#define _LIST_PREV(p)       ((node_head_t *)(void *)(p)->m_psPrev)
+/* Owners whose changes have to go through list.c */
+#define _LIST_F_SLOW        (_LIST_F_HOOKED|_NODE_F_MAPPED|_LIST_F_STATS)
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          list_node_first_inline
+ * @param [in]  pvListEntry  - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Inline list_node_first
+ *****************************************************************************/
+static inline void *list_node_first_inline( void *pvListEntry )
+{
+    node_head_t *psList = _LIST_HEAD(pvListEntry);
+    if( !_LIST_CHECK(_IS_ENTRY(psList)) || !_HAS_NODE(psList) ) {
+        return NULL;
+    }
+    return _LIST_USER(psList->m_psNext);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_last_inline
+ * @param [in]  pvListEntry  - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Inline list_node_last
+ *****************************************************************************/
+static inline void *list_node_last_inline( void *pvListEntry )
+{
+    node_head_t *psList = _LIST_HEAD(pvListEntry);
+    if( !_LIST_CHECK(_IS_ENTRY(psList)) || !_HAS_NODE(psList) ) {
+        return NULL;
+    }
+    return _LIST_USER(psList->m_psPrev);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_next_inline
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the next node or NULL if reach the end
+ * @brief       Inline list_node_next. The end is told by the entry flag of
+ *              the next node, which works for every kind of list.
+ *****************************************************************************/
+static inline void *list_node_next_inline( void *pvNode )
+{
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    node_head_t *psNext;
+    if( !_LIST_CHECK(_IS_USED_NODE(psHead)) ) {
+        return NULL;
+    }
+    psNext = _LIST_NEXT(psHead);
+    return (psNext->m_uiFlags & _NODE_F_ENTRY)?NULL:_LIST_USER(psNext);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_prev_inline
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the previous node or NULL if reach the beginning
+ * @brief       Inline list_node_prev
+ *****************************************************************************/
+static inline void *list_node_prev_inline( void *pvNode )
+{
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    node_head_t *psPrev;
+    if( !_LIST_CHECK(_IS_USED_NODE(psHead)) ) {
+        return NULL;
+    }
+    psPrev = _LIST_PREV(psHead);
+    return (psPrev->m_uiFlags & _NODE_F_ENTRY)?NULL:_LIST_USER(psPrev);
+}
+
+/**************************************************************************//**
+ * @fn          list_node_size_inline
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      The size of user data field
+ * @brief       Inline list_node_size
+ *****************************************************************************/
+static inline uint32_t list_node_size_inline( void *pvNode )
+{
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    return _LIST_CHECK(_IS_NODE(psHead))?psHead->m_uiSize:0;
+}
+
+/**************************************************************************//**
+ * @fn          list_length_inline
+ * @param [in]  pvListEntry - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Inline list_length
+ *****************************************************************************/
+static inline uint32_t list_length_inline( void *pvListEntry )
+{
+    node_head_t *psList = _LIST_HEAD(pvListEntry);
+    if( !_LIST_CHECK(_IS_ENTRY(psList)) ) {
+        return 0;
+    }
+    return (psList->m_uiFlags & _LIST_F_NO_OWNER)?list_length( pvListEntry ):psList->m_uiSize;
+}
+
+/**************************************************************************//**
+ * @fn          list_add_rear_inline
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node
+ * @return      None
+ * @brief       Inline list_add_rear
+ *****************************************************************************/
+static inline void list_add_rear_inline( void *pvListEntry, void *pvNode )
+{
+    node_head_t *psList = _LIST_HEAD(pvListEntry);
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    if( !_LIST_CHECK(_IS_ENTRY(psList) && _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead)) ) {
+        return;
+    }
+    if( psList->m_uiFlags & (_LIST_F_SLOW | _LIST_F_NO_OWNER) ) {
+        list_add_rear( pvListEntry, pvNode );
+        return;
+    }
+    psHead->m_psList = psList;
+    psHead->m_psPrev = psList->m_psPrev;
+    psHead->m_psNext = _LIST_LINK(psList);
+    _LIST_PREV(psList)->m_psNext = _LIST_LINK(psHead);
+    psList->m_psPrev = _LIST_LINK(psHead);
+    psList->m_uiSize++;
+}
+
+/**************************************************************************//**
+ * @fn          list_add_front_inline
+ * @param [in]  pvListEntry - List handle
+ * @param [in]  pvNode      - Pointer to a node
+ * @return      None
+ * @brief       Inline list_add_front
+ *****************************************************************************/
+static inline void list_add_front_inline( void *pvListEntry, void *pvNode )
+{
+    node_head_t *psList = _LIST_HEAD(pvListEntry);
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    if( !_LIST_CHECK(_IS_ENTRY(psList) && _IS_IDLE_NODE(psHead) && _POOL_MATCH(psList, psHead)) ) {
+        return;
+    }
+    if( psList->m_uiFlags & (_LIST_F_SLOW | _LIST_F_NO_OWNER) ) {
+        list_add_front( pvListEntry, pvNode );
+        return;
+    }
+    psHead->m_psList = psList;
+    psHead->m_psPrev = _LIST_LINK(psList);
+    psHead->m_psNext = psList->m_psNext;
+    _LIST_NEXT(psList)->m_psPrev = _LIST_LINK(psHead);
+    psList->m_psNext = _LIST_LINK(psHead);
+    psList->m_uiSize++;
+}
+
+/**************************************************************************//**
+ * @fn          list_insert_before_inline
+ * @param [in]  pvNodeA - Pointer to a node.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Inline list_insert_before
+ *****************************************************************************/
+static inline void list_insert_before_inline( void *pvNodeA, void *pvNodeB )
+{
+    node_head_t *psHeadA = _LIST_HEAD(pvNodeA);
+    node_head_t *psHeadB = _LIST_HEAD(pvNodeB);
+    node_head_t *psOwner;
+    if( !_LIST_CHECK(_IS_USED_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB)
+                     && _POOL_MATCH(psHeadA->m_psList, psHeadB)) ) {
+        return;
+    }
+    psOwner = psHeadA->m_psList;
+    if( psOwner->m_uiFlags & _LIST_F_SLOW ) {
+        list_insert_before( pvNodeA, pvNodeB );
+        return;
+    }
+    psHeadB->m_psList = psOwner;
+    psHeadB->m_psNext = _LIST_LINK(psHeadA);
+    psHeadB->m_psPrev = psHeadA->m_psPrev;
+    _LIST_PREV(psHeadA)->m_psNext = _LIST_LINK(psHeadB);
+    psHeadA->m_psPrev = _LIST_LINK(psHeadB);
+    if( !(psOwner->m_uiFlags & _LIST_F_NO_OWNER) ) {
+        psOwner->m_uiSize++;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          ilst_insert_after_inline
+ * @param [in]  pvNodeA - Pointer to a node.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Inline ilst_insert_after
+ *****************************************************************************/
+static inline void ilst_insert_after_inline( void *pvNodeA, void *pvNodeB )
+{
+    node_head_t *psHeadA = _LIST_HEAD(pvNodeA);
+    node_head_t *psHeadB = _LIST_HEAD(pvNodeB);
+    node_head_t *psOwner;
+    if( !_LIST_CHECK(_IS_USED_NODE(psHeadA) && _IS_IDLE_NODE(psHeadB)
+                     && _POOL_MATCH(psHeadA->m_psList, psHeadB)) ) {
+        return;
+    }
+    psOwner = psHeadA->m_psList;
+    if( psOwner->m_uiFlags & _LIST_F_SLOW ) {
+        ilst_insert_after( pvNodeA, pvNodeB );
+        return;
+    }
+    psHeadB->m_psList = psOwner;
+    psHeadB->m_psPrev = _LIST_LINK(psHeadA);
+    psHeadB->m_psNext = psHeadA->m_psNext;
+    _LIST_NEXT(psHeadA)->m_psPrev = _LIST_LINK(psHeadB);
+    psHeadA->m_psNext = _LIST_LINK(psHeadB);
+    if( !(psOwner->m_uiFlags & _LIST_F_NO_OWNER) ) {
+        psOwner->m_uiSize++;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          list_node_del_inline
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      None
+ * @brief       Inline list_node_del
+ *****************************************************************************/
+static inline void list_node_del_inline( void *pvNode )
+{
+    node_head_t *psHead = _LIST_HEAD(pvNode);
+    node_head_t *psOwner;
+    if( !_LIST_CHECK(_IS_USED_NODE(psHead)) ) {
+        return;
+    }
+    psOwner = psHead->m_psList;
+    if( psOwner->m_uiFlags & _LIST_F_SLOW ) {
+        list_node_del( pvNode );
+        return;
+    }
+    _LIST_PREV(psHead)->m_psNext = psHead->m_psNext;
+    _LIST_NEXT(psHead)->m_psPrev = psHead->m_psPrev;
+    if( !(psOwner->m_uiFlags & _LIST_F_NO_OWNER) ) {
+        psOwner->m_uiSize--;
+    }
+    psHead->m_psList = NULL;
+}
+
+/* Replace the functions of list.c from here on */
+#define list_node_first(l)          list_node_first_inline(l)
+#define list_node_last(l)           list_node_last_inline(l)
+#define list_node_next(n)           list_node_next_inline(n)
+#define list_node_prev(n)           list_node_prev_inline(n)
+#define list_node_size(n)           list_node_size_inline(n)
+#define list_length(l)              list_length_inline(l)
+#define list_add_rear(l,n)          list_add_rear_inline(l,n)
+#define list_add_front(l,n)         list_add_front_inline(l,n)
+#define list_insert_before(a,b)     list_insert_before_inline(a,b)
+#define ilst_insert_after(a,b)      ilst_insert_after_inline(a,b)
+#define list_node_del(n)            list_node_del_inline(n)
+
+#endif /* _LIST_INLINE_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,90 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        list_priv.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Node flags and checks shared by list.c and list_inline.h
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _LIST_PRIV_H_
+#define _LIST_PRIV_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include "list.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _HEAD_SIZE   (sizeof(node_head_t))
+
+#define _NODE_F_EXTERN      (0x00000001u)   /* Link embedded in user memory */
+#define _NODE_F_ENTRY       (0x00000002u)   /* Entry of a list */
+#define _LIST_F_NO_OWNER    (0x00000004u)   /* Nodes do not track the list */
+#define _NODE_F_MAPPED      (0x00000008u)   /* Read-only in a mapped image */
+#define _LIST_F_HOOKED      (0x00000010u)   /* Has an index or a skip list */
+#define _LIST_F_STATS       (0x00000020u)   /* Counted with LIST_CFG_STATS */
+#define _NODE_F_TOWER       (0x00000040u)   /* Has a tower in the skip list */
+#define _NODE_F_HELD        (0x00000080u)   /* In a queue or a concurrent list */
+#define _NODE_F_POOLED      (0x00000100u)   /* Pool pointer in front of the head */
+
+#define _IS_ENTRY(p)        (((p))&&((p)->m_psList==(p)))
+#define _HAS_NODE(p)        (((void*)p)!=((void*)(p)->m_psNext))
+#define _IS_NODE(p)         (((p))&&(p->m_psList!=(p)))
+#define _IS_IDLE_NODE(p)    ((_IS_NODE(p))&&(!(p)->m_psList))
+#define _IS_USED_NODE(p)    ((_IS_NODE(p))&&((p)->m_psList)&&(!_IS_HELD(p)))
+#define _IS_HELD(p)         ((p)->m_uiFlags&_NODE_F_HELD)
+#define _IS_MAPPED(p)       ((p)->m_uiFlags&_NODE_F_MAPPED)
+#define _IS_RW_ENTRY(p)     ((_IS_ENTRY(p))&&(!_IS_MAPPED(p)))
+#define _IS_RW_NODE(p)      ((_IS_USED_NODE(p))&&(!_IS_MAPPED(p)))
+#define _TO_HEAD_ADDR(p)    ((p)?((void*)(p)-_HEAD_SIZE):(NULL))
+#define _TO_USER_ADDR(p)    ((void*)(p)+_HEAD_SIZE)
+#define _NODE_POOL(p)       (((p)->m_uiFlags&_NODE_F_POOLED)?(((struct _LIST_POOL_T **)(p))[-1]):(NULL))
+#define _LIST_POOL(l)       (((list_ctrl_t *)(l))->m_psPool)
+#define _POOL_MATCH(l,p)    ((!_LIST_POOL(l))||(_LIST_POOL(l)==_NODE_POOL(p)))
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _LIST_CTRL_T list_ctrl_t;
+
+/* Control block of a list, the entry is the first member so that a list
+ * handle stays a node head */
+struct _LIST_CTRL_T {
+    node_head_t m_stEntry;
+    struct _LIST_POOL_T *m_psPool;      /* Pool of every node or NULL */
+    struct _LIST_INDEX_T *m_psIndex;
+    struct _LIST_SKIP_T *m_psSkip;
+};
+
+#endif /* _LIST_PRIV_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,226 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        lru.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Fixed capacity LRU cache built on a pooled and indexed list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "lru.h"
+#include "string.h"
+#include "stdlib.h"
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _LRU_T lru_t;
+
+/* The list runs from the most to the least recently used entry. Its nodes
+ * and the slots of its hash index share one pool chunk made for exactly
+ * uiCapacity entries, so neither grows after creation. */
+struct _LRU_T {
+    void *m_pvList;
+    void *m_pvPool;
+    list_key_t m_pfnKey;
+    lru_evict_t m_pfnEvict;
+    uint32_t m_uiCapacity;
+    uint32_t m_uiDataSize;
+};
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _lru_touch
+ * @param [in]  psLru  - Pointer to a cache
+ * @param [in]  pvNode - Pointer to the node of an entry
+ * @return      None
+ * @brief       Make an entry the most recently used one. Splicing within the
+ *              list relinks the node only and leaves the hash index alone.
+ *****************************************************************************/
+static inline void _lru_touch( lru_t *psLru, void *pvNode )
+{
+    list_splice( psLru->m_pvList, list_node_first( psLru->m_pvList ), pvNode, pvNode );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          lru_create
+ * @param [in]  uiCapacity - Maximum number of entries
+ * @param [in]  uiDataSize - Size of the user data field of an entry, which
+ *                           holds the key
+ * @param [in]  pfnKey     - Function giving the key within a user data field
+ * @param [in]  pfnHash    - Hash function on keys
+ * @param [in]  pfnEq      - Equality function on keys
+ * @param [in]  pfnEvict   - Eviction callback or NULL
+ * @return      Handle of the created cache or NULL if failed
+ * @brief       Create an empty LRU cache. The nodes of all entries and the
+ *              hash slots for them are allocated here in one region, so a
+ *              cache does not allocate memory once created.
+ *****************************************************************************/
+void *lru_create( uint32_t uiCapacity, uint32_t uiDataSize, list_key_t pfnKey,
+                  list_hash_t pfnHash, list_eq_t pfnEq, lru_evict_t pfnEvict )
+{
+    lru_t *psLru;
+    if( !uiCapacity || !pfnKey || !pfnHash || !pfnEq ) {
+        return NULL;
+    }
+    psLru = calloc( 1, sizeof( lru_t ) );
+    if( !psLru ) {
+        return NULL;
+    }
+    psLru->m_pfnKey = pfnKey;
+    psLru->m_pfnEvict = pfnEvict;
+    psLru->m_uiCapacity = uiCapacity;
+    psLru->m_uiDataSize = uiDataSize;
+    psLru->m_pvPool = list_pool_create( uiDataSize, uiCapacity );
+    psLru->m_pvList = list_create_from( psLru->m_pvPool );
+    if( !list_index_create( psLru->m_pvList, pfnKey, pfnHash, pfnEq )
+        || !list_reserve( psLru->m_pvList, uiCapacity ) ) {
+        lru_destroy( psLru );
+        return NULL;
+    }
+    return psLru;
+}
+
+/**************************************************************************//**
+ * @fn          lru_get
+ * @param [in]  pvLru - Cache handle
+ * @param [in]  pvKey - Pointer to the key to look for
+ * @return      Pointer to the user data field of the entry or NULL if missed
+ * @brief       Look an entry up and make it the most recently used one, in
+ *              O(1) on average
+ *****************************************************************************/
+void *lru_get( void *pvLru, const void *pvKey )
+{
+    lru_t *psLru = pvLru;
+    void *pvNode;
+    if( !psLru ) {
+        return NULL;
+    }
+    pvNode = list_find( psLru->m_pvList, pvKey );
+    if( pvNode ) {
+        _lru_touch( psLru, pvNode );
+    }
+    return pvNode;
+}
+
+/**************************************************************************//**
+ * @fn          lru_put
+ * @param [in]  pvLru  - Cache handle
+ * @param [in]  pvData - User data field to copy in, including the key
+ * @return      Pointer to the user data field of the entry or NULL if failed
+ * @brief       Store an entry as the most recently used one. An entry with
+ *              the same key is overwritten, otherwise the least recently used
+ *              entry is evicted when the cache is full.
+ *****************************************************************************/
+void *lru_put( void *pvLru, const void *pvData )
+{
+    lru_t *psLru = pvLru;
+    void *pvNode;
+    if( !psLru || !pvData ) {
+        return NULL;
+    }
+    pvNode = list_find( psLru->m_pvList, psLru->m_pfnKey( pvData ) );
+    if( pvNode ) {
+        memcpy( pvNode, pvData, psLru->m_uiDataSize );
+        _lru_touch( psLru, pvNode );
+        return pvNode;
+    }
+    if( list_length( psLru->m_pvList ) < psLru->m_uiCapacity ) {
+        pvNode = list_node_alloc_from( psLru->m_pvPool );
+    } else {
+        pvNode = list_node_last( psLru->m_pvList );
+        if( psLru->m_pfnEvict ) {
+            psLru->m_pfnEvict( pvNode );
+        }
+        list_node_del( pvNode );
+    }
+    if( pvNode ) {
+        memcpy( pvNode, pvData, psLru->m_uiDataSize );
+        list_add_front( psLru->m_pvList, pvNode );
+    }
+    return pvNode;
+}
+
+/**************************************************************************//**
+ * @fn          lru_remove
+ * @param [in]  pvLru - Cache handle
+ * @param [in]  pvKey - Pointer to the key of the entry
+ * @return      true if removed, false if not founded
+ * @brief       Drop an entry without calling the eviction callback
+ *****************************************************************************/
+bool lru_remove( void *pvLru, const void *pvKey )
+{
+    lru_t *psLru = pvLru;
+    void *pvNode = psLru?list_find( psLru->m_pvList, pvKey ):NULL;
+    if( pvNode ) {
+        list_node_del( pvNode );
+        list_node_free( pvNode );
+    }
+    return (pvNode != NULL);
+}
+
+/**************************************************************************//**
+ * @fn          lru_length
+ * @param [in]  pvLru - Cache handle
+ * @return      Number of entries
+ * @brief       Get the number of entries in a cache
+ *****************************************************************************/
+uint32_t lru_length( void *pvLru )
+{
+    lru_t *psLru = pvLru;
+    return psLru?list_length( psLru->m_pvList ):0;
+}
+
+/**************************************************************************//**
+ * @fn          lru_destroy
+ * @param [in]  pvLru - Cache handle
+ * @return      None
+ * @brief       Free a cache and all its entries without calling the eviction
+ *              callback
+ *****************************************************************************/
+void lru_destroy( void *pvLru )
+{
+    lru_t *psLru = pvLru;
+    if( psLru ) {
+        list_destroy( psLru->m_pvList );
+        list_pool_destroy( psLru->m_pvPool );
+        free( psLru );
+    }
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
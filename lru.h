@@ -0,0 +1,127 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        lru.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Fixed capacity LRU cache built on a pooled and indexed list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _LRU_H_
+#define _LRU_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type Definitions -------------------------------------------------------- */
+
+/* Called with the user data field of an entry before it is evicted */
+typedef void (*lru_evict_t)( void *pvData );
+
+/* External Interfaces ----------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          lru_create
+ * @param [in]  uiCapacity - Maximum number of entries
+ * @param [in]  uiDataSize - Size of the user data field of an entry, which
+ *                           holds the key
+ * @param [in]  pfnKey     - Function giving the key within a user data field
+ * @param [in]  pfnHash    - Hash function on keys
+ * @param [in]  pfnEq      - Equality function on keys
+ * @param [in]  pfnEvict   - Eviction callback or NULL
+ * @return      Handle of the created cache or NULL if failed
+ * @brief       Create an empty LRU cache. The nodes of all entries and the
+ *              hash slots for them are allocated here, so a cache does not
+ *              allocate memory once created.
+ *****************************************************************************/
+void *lru_create( uint32_t uiCapacity, uint32_t uiDataSize, list_key_t pfnKey,
+                  list_hash_t pfnHash, list_eq_t pfnEq, lru_evict_t pfnEvict );
+
+/**************************************************************************//**
+ * @fn          lru_get
+ * @param [in]  pvLru - Cache handle
+ * @param [in]  pvKey - Pointer to the key to look for
+ * @return      Pointer to the user data field of the entry or NULL if missed
+ * @brief       Look an entry up and make it the most recently used one, in
+ *              O(1) on average
+ *****************************************************************************/
+void *lru_get( void *pvLru, const void *pvKey );
+
+/**************************************************************************//**
+ * @fn          lru_put
+ * @param [in]  pvLru  - Cache handle
+ * @param [in]  pvData - User data field to copy in, including the key
+ * @return      Pointer to the user data field of the entry or NULL if failed
+ * @brief       Store an entry as the most recently used one. An entry with
+ *              the same key is overwritten, otherwise the least recently used
+ *              entry is evicted when the cache is full.
+ *****************************************************************************/
+void *lru_put( void *pvLru, const void *pvData );
+
+/**************************************************************************//**
+ * @fn          lru_remove
+ * @param [in]  pvLru - Cache handle
+ * @param [in]  pvKey - Pointer to the key of the entry
+ * @return      true if removed, false if not founded
+ * @brief       Drop an entry without calling the eviction callback
+ *****************************************************************************/
+bool lru_remove( void *pvLru, const void *pvKey );
+
+/**************************************************************************//**
+ * @fn          lru_length
+ * @param [in]  pvLru - Cache handle
+ * @return      Number of entries
+ * @brief       Get the number of entries in a cache
+ *****************************************************************************/
+uint32_t lru_length( void *pvLru );
+
+/**************************************************************************//**
+ * @fn          lru_destroy
+ * @param [in]  pvLru - Cache handle
+ * @return      None
+ * @brief       Free a cache and all its entries without calling the eviction
+ *              callback
+ *****************************************************************************/
+void lru_destroy( void *pvLru );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LRU_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,282 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        mpscq.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Lock-free multi-producer single-consumer queue of list nodes
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "mpscq.h"
+#include "list_priv.h"
+#include "string.h"
+#include "stdlib.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _CACHE_LINE         (64)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define _CPU_RELAX()        __builtin_ia32_pause()
+#else
+#define _CPU_RELAX()        __atomic_signal_fence( __ATOMIC_SEQ_CST )
+#endif
+
+#define _NEXT(p)            ((node_head_t *)(p)->m_psNext)
+#define _LOAD_NEXT(p)       ((node_head_t *)__atomic_load_n( &(p)->m_psNext, __ATOMIC_ACQUIRE ))
+#define _STORE_NEXT(p,n)    (__atomic_store_n( &(p)->m_psNext, (void *)(n), __ATOMIC_RELEASE ))
+#define _IS_STUB(q,p)       (((p)==&(q)->m_astStub[0])||((p)==&(q)->m_astStub[1]))
+/* Owner recorded by queued nodes so that they are not idle, and the flag
+ * keeps list calls off them while they are linked in the queue */
+#define _QUEUED(q)          (&(q)->m_astStub[0])
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _MPSCQ_T mpscq_t;
+
+/* Vyukov's intrusive queue. Producers swap themselves into m_psTail and then
+ * link the former tail to them, the consumer follows m_psNext from m_psHead.
+ * Two stubs take turns so that mpscq_dequeue_all can cut the whole chain off
+ * while producers go on appending after the other one. */
+struct _MPSCQ_T {
+    node_head_t *m_psTail;                  /* Shared by producers */
+    uint8_t m_aPad[_CACHE_LINE - sizeof(node_head_t *)];
+    node_head_t *m_psHead;                  /* Consumer only from here on */
+    node_head_t *m_psStub;
+    node_head_t m_astStub[2];
+};
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _push
+ * @param [in]  psQueue - Pointer to a queue
+ * @param [in]  psHead  - Pointer to a node head
+ * @return      None
+ * @brief       Append a node head to the chain
+ *****************************************************************************/
+static void _push( mpscq_t *psQueue, node_head_t *psHead )
+{
+    node_head_t *psPrev;
+    psHead->m_psNext = NULL;
+    psPrev = __atomic_exchange_n( &psQueue->m_psTail, psHead, __ATOMIC_ACQ_REL );
+    _STORE_NEXT(psPrev, psHead);
+}
+
+/**************************************************************************//**
+ * @fn          _wait_next
+ * @param [in]  psHead - Pointer to a node head known not to be the tail
+ * @return      The next node head
+ * @brief       Wait for a producer to finish linking the next node. It is
+ *              only a couple of instructions behind its atomic exchange.
+ *****************************************************************************/
+static node_head_t *_wait_next( node_head_t *psHead )
+{
+    node_head_t *psNext;
+    while( !(psNext = _LOAD_NEXT(psHead)) ) {
+        _CPU_RELAX();
+    }
+    return psNext;
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          mpscq_create
+ * @param       None
+ * @return      Handle of the created queue or NULL if failed
+ * @brief       Create a new empty queue. Any number of threads may enqueue
+ *              while one thread at a time dequeues.
+ *****************************************************************************/
+void *mpscq_create( void )
+{
+    mpscq_t *psQueue = NULL;
+    if( posix_memalign( (void **)&psQueue, _CACHE_LINE, sizeof( mpscq_t ) ) ) {
+        return NULL;
+    }
+    memset( psQueue, 0, sizeof( mpscq_t ) );
+    psQueue->m_psStub = &psQueue->m_astStub[0];
+    psQueue->m_psHead = psQueue->m_psStub;
+    psQueue->m_psTail = psQueue->m_psStub;
+    return psQueue;
+}
+
+/**************************************************************************//**
+ * @fn          mpscq_enqueue
+ * @param [in]  pvQueue - Queue handle
+ * @param [in]  pvNode  - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the end of a queue. Wait-free, it takes one
+ *              atomic exchange and one store. The node is not idle until it
+ *              is dequeued again.
+ *****************************************************************************/
+void mpscq_enqueue( void *pvQueue, void *pvNode )
+{
+    mpscq_t *psQueue = pvQueue;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( psQueue && psHead && !psHead->m_psList ) {
+        psHead->m_psList = _QUEUED(psQueue);
+        psHead->m_uiFlags |= _NODE_F_HELD;
+        _push( psQueue, psHead );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          mpscq_dequeue
+ * @param [in]  pvQueue - Queue handle
+ * @return      Pointer to the node or NULL if none is ready
+ * @brief       Take the node at the beginning of a queue. Consumer only. It
+ *              may return NULL while a producer is halfway through
+ *              mpscq_enqueue; the node shows up on a later call.
+ *****************************************************************************/
+void *mpscq_dequeue( void *pvQueue )
+{
+    mpscq_t *psQueue = pvQueue;
+    node_head_t *psHead;
+    node_head_t *psNext;
+    if( !psQueue ) {
+        return NULL;
+    }
+    psHead = psQueue->m_psHead;
+    psNext = _LOAD_NEXT(psHead);
+    if( psHead == psQueue->m_psStub ) {
+        if( !psNext ) {
+            return NULL;
+        }
+        psQueue->m_psHead = psHead = psNext;
+        psNext = _LOAD_NEXT(psHead);
+    }
+    if( !psNext ) {
+        if( psHead != __atomic_load_n( &psQueue->m_psTail, __ATOMIC_ACQUIRE ) ) {
+            return NULL;
+        }
+        /* Last node, put the stub behind it so that it can be taken */
+        _push( psQueue, psQueue->m_psStub );
+        psNext = _LOAD_NEXT(psHead);
+        if( !psNext ) {
+            return NULL;
+        }
+    }
+    psQueue->m_psHead = psNext;
+    psHead->m_uiFlags &= ~_NODE_F_HELD;
+    psHead->m_psList = NULL;
+    return _TO_USER_ADDR(psHead);
+}
+
+/**************************************************************************//**
+ * @fn          mpscq_dequeue_all
+ * @param [in]  pvQueue - Queue handle
+ * @return      Pointer to the first node of the chain or NULL if empty
+ * @brief       Detach all nodes of a queue in one atomic exchange. Consumer
+ *              only. The nodes come back idle, in order and chained for
+ *              mpscq_chain_next.
+ *****************************************************************************/
+void *mpscq_dequeue_all( void *pvQueue )
+{
+    mpscq_t *psQueue = pvQueue;
+    node_head_t *psStub;
+    node_head_t *psHead;
+    node_head_t *psLast;
+    node_head_t *psNext;
+    node_head_t sFirst;
+    node_head_t *psTail = &sFirst;
+    if( !psQueue ) {
+        return NULL;
+    }
+    psHead = psQueue->m_psHead;
+    if( psHead == psQueue->m_psStub && !_LOAD_NEXT(psHead)
+        && psHead == __atomic_load_n( &psQueue->m_psTail, __ATOMIC_ACQUIRE ) ) {
+        return NULL;
+    }
+    /* Switch to the idle stub, producers go on appending after it */
+    psStub = (psQueue->m_psStub == &psQueue->m_astStub[0])?
+             &psQueue->m_astStub[1]:&psQueue->m_astStub[0];
+    psStub->m_psNext = NULL;
+    psLast = __atomic_exchange_n( &psQueue->m_psTail, psStub, __ATOMIC_ACQ_REL );
+    psQueue->m_psStub = psStub;
+    psQueue->m_psHead = psStub;
+    /* Collect the old chain, dropping the former stub */
+    for( ;; ) {
+        psNext = (psHead != psLast)?_wait_next( psHead ):NULL;
+        if( !_IS_STUB(psQueue, psHead) ) {
+            psHead->m_uiFlags &= ~_NODE_F_HELD;
+            psHead->m_psList = NULL;
+            psTail->m_psNext = (void *)psHead;
+            psTail = psHead;
+        }
+        if( !psNext ) {
+            break;
+        }
+        psHead = psNext;
+    }
+    psTail->m_psNext = NULL;
+    return sFirst.m_psNext?_TO_USER_ADDR(sFirst.m_psNext):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          mpscq_chain_next
+ * @param [in]  pvNode - Pointer to a node got by mpscq_dequeue_all
+ * @return      Pointer to the next node or NULL if reach the end of chain
+ * @brief       Get the next node of a detached chain. Read it before adding
+ *              the node to a list, which overwrites the chain link.
+ *****************************************************************************/
+void *mpscq_chain_next( void *pvNode )
+{
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    return (psHead && psHead->m_psNext)?_TO_USER_ADDR(_NEXT(psHead)):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          mpscq_destroy
+ * @param [in]  pvQueue - Queue handle
+ * @return      None
+ * @brief       Free the queue including all nodes in it. No producer may
+ *              still use the queue.
+ *****************************************************************************/
+void mpscq_destroy( void *pvQueue )
+{
+    void *pvNode;
+    void *pvNext;
+    if( pvQueue ) {
+        for( pvNode = mpscq_dequeue_all( pvQueue ); pvNode; pvNode = pvNext ) {
+            pvNext = mpscq_chain_next( pvNode );
+            list_node_free( pvNode );
+        }
+        free( pvQueue );
+    }
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,116 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        mpscq.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Lock-free multi-producer single-consumer queue of list nodes
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _MPSCQ_H_
+#define _MPSCQ_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* External Interfaces ----------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          mpscq_create
+ * @param       None
+ * @return      Handle of the created queue or NULL if failed
+ * @brief       Create a new empty queue. Any number of threads may enqueue
+ *              while one thread at a time dequeues.
+ *****************************************************************************/
+void *mpscq_create( void );
+
+/**************************************************************************//**
+ * @fn          mpscq_enqueue
+ * @param [in]  pvQueue - Queue handle
+ * @param [in]  pvNode  - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the end of a queue. Wait-free, it takes one
+ *              atomic exchange and one store. The node is not idle and list
+ *              calls leave it alone until it is dequeued again.
+ *****************************************************************************/
+void mpscq_enqueue( void *pvQueue, void *pvNode );
+
+/**************************************************************************//**
+ * @fn          mpscq_dequeue
+ * @param [in]  pvQueue - Queue handle
+ * @return      Pointer to the node or NULL if none is ready
+ * @brief       Take the node at the beginning of a queue. Consumer only. It
+ *              may return NULL while a producer is halfway through
+ *              mpscq_enqueue; the node shows up on a later call.
+ *****************************************************************************/
+void *mpscq_dequeue( void *pvQueue );
+
+/**************************************************************************//**
+ * @fn          mpscq_dequeue_all
+ * @param [in]  pvQueue - Queue handle
+ * @return      Pointer to the first node of the chain or NULL if empty
+ * @brief       Detach all nodes of a queue in one atomic exchange. Consumer
+ *              only. The nodes come back idle, in order and chained for
+ *              mpscq_chain_next.
+ *****************************************************************************/
+void *mpscq_dequeue_all( void *pvQueue );
+
+/**************************************************************************//**
+ * @fn          mpscq_chain_next
+ * @param [in]  pvNode - Pointer to a node got by mpscq_dequeue_all
+ * @return      Pointer to the next node or NULL if reach the end of chain
+ * @brief       Get the next node of a detached chain. Read it before adding
+ *              the node to a list, which overwrites the chain link.
+ *****************************************************************************/
+void *mpscq_chain_next( void *pvNode );
+
+/**************************************************************************//**
+ * @fn          mpscq_destroy
+ * @param [in]  pvQueue - Queue handle
+ * @return      None
+ * @brief       Free the queue including all nodes in it. No producer may
+ *              still use the queue.
+ *****************************************************************************/
+void mpscq_destroy( void *pvQueue );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MPSCQ_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
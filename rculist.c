@@ -0,0 +1,471 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        rculist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Read-mostly concurrent list with lock-free readers
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "rculist.h"
+#include "list_priv.h"
+#include "string.h"
+#include "stdlib.h"
+#include <pthread.h>
+#include <sched.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _CACHE_LINE         (64)
+#define _LIMBO_BUCKETS      (3)
+
+#define _IS_MEMBER(l,p)     (((p))&&((p)->m_psList==&(l)->m_stEntry))
+#define _LOAD_NEXT(p)       ((node_head_t *)__atomic_load_n( &(p)->m_psNext, __ATOMIC_ACQUIRE ))
+#define _STORE_NEXT(p,n)    (__atomic_store_n( &(p)->m_psNext, (void *)(n), __ATOMIC_RELEASE ))
+
+/* Epoch word of a reader, zero when out of any read section */
+#define _ACTIVE(e)          (((e)<<1)|1)
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _RCU_READER_T rcu_reader_t;
+typedef struct _RCU_LIST_T rcu_list_t;
+
+struct _RCU_READER_T {
+    uint64_t m_ulEpoch;                     /* Written by its reader only */
+    rcu_reader_t *m_psNext;
+    rcu_list_t *m_psList;
+};
+
+/* Epoch based reclamation. A node deleted in epoch e goes to limbo bucket
+ * e % 3. The epoch only moves on when every reader in a read section has
+ * seen the current one, so once it reaches e + 2 no reader can still hold a
+ * node of bucket e. Limbo buckets are chained by m_psPrev, which readers
+ * never follow, while m_psNext keeps leading readers back into the list. */
+struct _RCU_LIST_T {
+    node_head_t m_stEntry;
+    uint64_t m_ulEpoch;
+    pthread_mutex_t m_sLock;                /* Serializes writers */
+    rcu_reader_t *m_psReaders;
+    node_head_t *m_apsLimbo[_LIMBO_BUCKETS];
+    uint32_t m_uiRetired;
+};
+
+/* Local Variables --------------------------------------------------------- */
+
+/* Owner recorded by deleted nodes waiting for their grace period */
+static node_head_t s_stRetired;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _link
+ * @param [in]  psList - Pointer to a list
+ * @param [in]  psPrev - Node head or entry to link after
+ * @param [in]  psHead - Pointer to an idle node head
+ * @return      None
+ * @brief       Link a node and publish it to readers. Lock held.
+ *****************************************************************************/
+static void _link( rcu_list_t *psList, node_head_t *psPrev, node_head_t *psHead )
+{
+    node_head_t *psNext = (void *)psPrev->m_psNext;
+    psHead->m_psList = &psList->m_stEntry;
+    psHead->m_uiFlags |= _NODE_F_HELD;
+    psHead->m_psPrev = (void *)psPrev;
+    psHead->m_psNext = (void *)psNext;
+    psNext->m_psPrev = (void *)psHead;
+    _STORE_NEXT(psPrev, psHead);
+    /* Serialized by the lock, atomic only for rculist_length */
+    __atomic_fetch_add( &psList->m_stEntry.m_uiSize, 1, __ATOMIC_RELAXED );
+}
+
+/**************************************************************************//**
+ * @fn          _reclaim
+ * @param [in]  psList   - Pointer to a list
+ * @param [in]  uiBucket - Index of a limbo bucket
+ * @return      None
+ * @brief       Free all nodes of a limbo bucket. Lock held.
+ *****************************************************************************/
+static void _reclaim( rcu_list_t *psList, uint32_t uiBucket )
+{
+    node_head_t *psHead;
+    while( psList->m_apsLimbo[uiBucket] ) {
+        psHead = psList->m_apsLimbo[uiBucket];
+        psList->m_apsLimbo[uiBucket] = (void *)psHead->m_psPrev;
+        psHead->m_uiFlags &= ~_NODE_F_HELD;
+        psHead->m_psList = NULL;
+        psList->m_uiRetired--;
+        list_node_free( _TO_USER_ADDR(psHead) );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _try_advance
+ * @param [in]  psList - Pointer to a list
+ * @return      true if the epoch moved on
+ * @brief       Move to the next epoch if every active reader has seen the
+ *              current one, then free the bucket two epochs behind. Lock held.
+ *****************************************************************************/
+static bool _try_advance( rcu_list_t *psList )
+{
+    uint64_t ulEpoch = psList->m_ulEpoch;
+    uint64_t ulSeen;
+    rcu_reader_t *psReader;
+    __atomic_thread_fence( __ATOMIC_SEQ_CST );
+    for( psReader = psList->m_psReaders; psReader; psReader = psReader->m_psNext ) {
+        ulSeen = __atomic_load_n( &psReader->m_ulEpoch, __ATOMIC_ACQUIRE );
+        if( ulSeen && ulSeen != _ACTIVE(ulEpoch) ) {
+            return false;
+        }
+    }
+    ulEpoch++;
+    __atomic_store_n( &psList->m_ulEpoch, ulEpoch, __ATOMIC_RELEASE );
+    _reclaim( psList, (ulEpoch + 1) % _LIMBO_BUCKETS );
+    return true;
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          rculist_create
+ * @param       None
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty concurrent list. Readers walk it forward
+ *              without locks or atomic read-modify-write operations, writers
+ *              are serialized by a mutex. Deleted nodes are freed once every
+ *              reader which might still see them has left its read section.
+ *****************************************************************************/
+void *rculist_create( void )
+{
+    rcu_list_t *psList = malloc( sizeof( rcu_list_t ) );
+    if( psList ) {
+        memset( psList, 0, sizeof( rcu_list_t ) );
+        psList->m_stEntry.m_psNext = (void *)&psList->m_stEntry;
+        psList->m_stEntry.m_psPrev = (void *)&psList->m_stEntry;
+        psList->m_stEntry.m_psList = &psList->m_stEntry;
+        if( pthread_mutex_init( &psList->m_sLock, NULL ) ) {
+            free( psList );
+            return NULL;
+        }
+    }
+    return psList;
+}
+
+/**************************************************************************//**
+ * @fn          rculist_reader_register
+ * @param [in]  pvList - List handle
+ * @return      Reader handle or NULL if failed
+ * @brief       Register a reader. Each reading thread needs its own handle.
+ *****************************************************************************/
+void *rculist_reader_register( void *pvList )
+{
+    rcu_list_t *psList = pvList;
+    rcu_reader_t *psReader = NULL;
+    if( !psList || posix_memalign( (void **)&psReader, _CACHE_LINE, _CACHE_LINE ) ) {
+        return NULL;
+    }
+    psReader->m_ulEpoch = 0;
+    psReader->m_psList = psList;
+    pthread_mutex_lock( &psList->m_sLock );
+    psReader->m_psNext = psList->m_psReaders;
+    psList->m_psReaders = psReader;
+    pthread_mutex_unlock( &psList->m_sLock );
+    return psReader;
+}
+
+/**************************************************************************//**
+ * @fn          rculist_reader_unregister
+ * @param [in]  pvList   - List handle
+ * @param [in]  pvReader - Reader handle out of any read section
+ * @return      None
+ * @brief       Unregister a reader and free its handle
+ *****************************************************************************/
+void rculist_reader_unregister( void *pvList, void *pvReader )
+{
+    rcu_list_t *psList = pvList;
+    rcu_reader_t **ppsReader;
+    if( !psList || !pvReader ) {
+        return;
+    }
+    pthread_mutex_lock( &psList->m_sLock );
+    for( ppsReader = &psList->m_psReaders; *ppsReader; ppsReader = &(*ppsReader)->m_psNext ) {
+        if( *ppsReader == pvReader ) {
+            *ppsReader = (*ppsReader)->m_psNext;
+            free( pvReader );
+            break;
+        }
+    }
+    pthread_mutex_unlock( &psList->m_sLock );
+}
+
+/**************************************************************************//**
+ * @fn          rculist_read_lock
+ * @param [in]  pvReader - Reader handle
+ * @return      None
+ * @brief       Enter a read section. Nodes got inside it stay valid until
+ *              rculist_read_unlock. Sections do not nest.
+ *****************************************************************************/
+void rculist_read_lock( void *pvReader )
+{
+    rcu_reader_t *psReader = pvReader;
+    uint64_t ulEpoch;
+    if( psReader ) {
+        ulEpoch = __atomic_load_n( &psReader->m_psList->m_ulEpoch, __ATOMIC_ACQUIRE );
+        __atomic_store_n( &psReader->m_ulEpoch, _ACTIVE(ulEpoch), __ATOMIC_RELAXED );
+        /* Publish the epoch before loading any link */
+        __atomic_thread_fence( __ATOMIC_SEQ_CST );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_read_unlock
+ * @param [in]  pvReader - Reader handle
+ * @return      None
+ * @brief       Leave a read section
+ *****************************************************************************/
+void rculist_read_unlock( void *pvReader )
+{
+    rcu_reader_t *psReader = pvReader;
+    if( psReader ) {
+        __atomic_store_n( &psReader->m_ulEpoch, 0, __ATOMIC_RELEASE );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_node_first
+ * @param [in]  pvList - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Get the node at the beginning of the list. Readers call it in
+ *              a read section, writers at any time.
+ *****************************************************************************/
+void *rculist_node_first( void *pvList )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead;
+    if( !psList ) {
+        return NULL;
+    }
+    psHead = _LOAD_NEXT(&psList->m_stEntry);
+    return (psHead != &psList->m_stEntry)?_TO_USER_ADDR(psHead):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          rculist_node_next
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the the next node
+ * @brief       Get next node or NULL if reach the end of list. A node deleted
+ *              meanwhile still leads back into the list.
+ *****************************************************************************/
+void *rculist_node_next( void *pvList, void *pvNode )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( !psList || !psHead ) {
+        return NULL;
+    }
+    psHead = _LOAD_NEXT(psHead);
+    return (psHead != &psList->m_stEntry)?_TO_USER_ADDR(psHead):NULL;
+}
+
+/**************************************************************************//**
+ * @fn          rculist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the end of a list
+ *****************************************************************************/
+void rculist_add_rear( void *pvList, void *pvNode )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( psList && _IS_IDLE_NODE(psHead) ) {
+        pthread_mutex_lock( &psList->m_sLock );
+        _link( psList, (void *)psList->m_stEntry.m_psPrev, psHead );
+        pthread_mutex_unlock( &psList->m_sLock );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the beginning of a list
+ *****************************************************************************/
+void rculist_add_front( void *pvList, void *pvNode )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    if( psList && _IS_IDLE_NODE(psHead) ) {
+        pthread_mutex_lock( &psList->m_sLock );
+        _link( psList, &psList->m_stEntry, psHead );
+        pthread_mutex_unlock( &psList->m_sLock );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_insert_after
+ * @param [in]  pvList  - List handle
+ * @param [in]  pvNodeA - Pointer to a node of the list.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Insert a node after another node.
+ *****************************************************************************/
+void rculist_insert_after( void *pvList, void *pvNodeA, void *pvNodeB )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHeadA = _TO_HEAD_ADDR(pvNodeA);
+    node_head_t *psHeadB = _TO_HEAD_ADDR(pvNodeB);
+    if( psList && psHeadA && _IS_IDLE_NODE(psHeadB) ) {
+        pthread_mutex_lock( &psList->m_sLock );
+        if( _IS_MEMBER(psList, psHeadA) ) {
+            _link( psList, psHeadA, psHeadB );
+        }
+        pthread_mutex_unlock( &psList->m_sLock );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_node_del
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to a node of the list.
+ * @return      None
+ * @brief       Delete a node from list. The node is freed by list_node_free
+ *              after a grace period, so it must not be used by the caller.
+ *****************************************************************************/
+void rculist_node_del( void *pvList, void *pvNode )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead = _TO_HEAD_ADDR(pvNode);
+    node_head_t *psPrev;
+    uint32_t uiBucket;
+    if( !psList || !psHead ) {
+        return;
+    }
+    pthread_mutex_lock( &psList->m_sLock );
+    if( _IS_MEMBER(psList, psHead) ) {
+        psPrev = (void *)psHead->m_psPrev;
+        _STORE_NEXT(psPrev, psHead->m_psNext);
+        ((node_head_t *)psHead->m_psNext)->m_psPrev = (void *)psPrev;
+        __atomic_fetch_sub( &psList->m_stEntry.m_uiSize, 1, __ATOMIC_RELAXED );
+        /* m_psNext is left alone for readers standing on the node */
+        uiBucket = psList->m_ulEpoch % _LIMBO_BUCKETS;
+        psHead->m_psList = &s_stRetired;
+        psHead->m_psPrev = (void *)psList->m_apsLimbo[uiBucket];
+        psList->m_apsLimbo[uiBucket] = psHead;
+        psList->m_uiRetired++;
+        _try_advance( psList );
+    }
+    pthread_mutex_unlock( &psList->m_sLock );
+}
+
+/**************************************************************************//**
+ * @fn          rculist_synchronize
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Wait until every node deleted so far has been freed. It must
+ *              not be called from a read section.
+ *****************************************************************************/
+void rculist_synchronize( void *pvList )
+{
+    rcu_list_t *psList = pvList;
+    uint32_t uiRetired;
+    if( !psList ) {
+        return;
+    }
+    for( ;; ) {
+        pthread_mutex_lock( &psList->m_sLock );
+        uiRetired = psList->m_uiRetired;
+        if( uiRetired ) {
+            _try_advance( psList );
+        }
+        pthread_mutex_unlock( &psList->m_sLock );
+        if( !uiRetired ) {
+            break;
+        }
+        sched_yield();
+    }
+}
+
+/**************************************************************************//**
+ * @fn          rculist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Get the number of nodes in a list.
+ *****************************************************************************/
+uint32_t rculist_length( void *pvList )
+{
+    rcu_list_t *psList = pvList;
+    return psList?__atomic_load_n( &psList->m_stEntry.m_uiSize, __ATOMIC_RELAXED ):0;
+}
+
+/**************************************************************************//**
+ * @fn          rculist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including all nodes and reader handles. No
+ *              thread may still use the list.
+ *****************************************************************************/
+void rculist_destroy( void *pvList )
+{
+    rcu_list_t *psList = pvList;
+    node_head_t *psHead;
+    rcu_reader_t *psReader;
+    uint32_t i;
+    if( !psList ) {
+        return;
+    }
+    while( psList->m_stEntry.m_psNext != (void *)&psList->m_stEntry ) {
+        psHead = (void *)psList->m_stEntry.m_psNext;
+        psList->m_stEntry.m_psNext = psHead->m_psNext;
+        psHead->m_uiFlags &= ~_NODE_F_HELD;
+        psHead->m_psList = NULL;
+        list_node_free( _TO_USER_ADDR(psHead) );
+    }
+    for( i = 0; i < _LIMBO_BUCKETS; i++ ) {
+        _reclaim( psList, i );
+    }
+    while( psList->m_psReaders ) {
+        psReader = psList->m_psReaders;
+        psList->m_psReaders = psReader->m_psNext;
+        free( psReader );
+    }
+    pthread_mutex_destroy( &psList->m_sLock );
+    free( psList );
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
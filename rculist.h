@@ -0,0 +1,186 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        rculist.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Read-mostly concurrent list with lock-free readers
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _RCULIST_H_
+#define _RCULIST_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* External Interfaces ----------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          rculist_create
+ * @param       None
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty concurrent list. Readers walk it forward
+ *              without locks or atomic read-modify-write operations, writers
+ *              are serialized by a mutex. Deleted nodes are freed once every
+ *              reader which might still see them has left its read section.
+ *****************************************************************************/
+void *rculist_create( void );
+
+/**************************************************************************//**
+ * @fn          rculist_reader_register
+ * @param [in]  pvList - List handle
+ * @return      Reader handle or NULL if failed
+ * @brief       Register a reader. Each reading thread needs its own handle.
+ *****************************************************************************/
+void *rculist_reader_register( void *pvList );
+
+/**************************************************************************//**
+ * @fn          rculist_reader_unregister
+ * @param [in]  pvList   - List handle
+ * @param [in]  pvReader - Reader handle out of any read section
+ * @return      None
+ * @brief       Unregister a reader and free its handle
+ *****************************************************************************/
+void rculist_reader_unregister( void *pvList, void *pvReader );
+
+/**************************************************************************//**
+ * @fn          rculist_read_lock
+ * @param [in]  pvReader - Reader handle
+ * @return      None
+ * @brief       Enter a read section. Nodes got inside it stay valid until
+ *              rculist_read_unlock. Sections do not nest.
+ *****************************************************************************/
+void rculist_read_lock( void *pvReader );
+
+/**************************************************************************//**
+ * @fn          rculist_read_unlock
+ * @param [in]  pvReader - Reader handle
+ * @return      None
+ * @brief       Leave a read section
+ *****************************************************************************/
+void rculist_read_unlock( void *pvReader );
+
+/**************************************************************************//**
+ * @fn          rculist_node_first
+ * @param [in]  pvList - List handle
+ * @return      Pointer to the node or NULL if not founded
+ * @brief       Get the node at the beginning of the list. Readers call it in
+ *              a read section, writers at any time.
+ *****************************************************************************/
+void *rculist_node_first( void *pvList );
+
+/**************************************************************************//**
+ * @fn          rculist_node_next
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to a node.
+ * @return      Pointer to the the next node
+ * @brief       Get next node or NULL if reach the end of list. A node deleted
+ *              meanwhile still leads back into the list.
+ *****************************************************************************/
+void *rculist_node_next( void *pvList, void *pvNode );
+
+/**************************************************************************//**
+ * @fn          rculist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the end of a list
+ *****************************************************************************/
+void rculist_add_rear( void *pvList, void *pvNode );
+
+/**************************************************************************//**
+ * @fn          rculist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to an idle node
+ * @return      None
+ * @brief       Add a node at the beginning of a list
+ *****************************************************************************/
+void rculist_add_front( void *pvList, void *pvNode );
+
+/**************************************************************************//**
+ * @fn          rculist_insert_after
+ * @param [in]  pvList  - List handle
+ * @param [in]  pvNodeA - Pointer to a node of the list.
+ * @param [in]  pvNodeB - Pointer to the node to be inserted.
+ * @return      None
+ * @brief       Insert a node after another node.
+ *****************************************************************************/
+void rculist_insert_after( void *pvList, void *pvNodeA, void *pvNodeB );
+
+/**************************************************************************//**
+ * @fn          rculist_node_del
+ * @param [in]  pvList - List handle
+ * @param [in]  pvNode - Pointer to a node of the list.
+ * @return      None
+ * @brief       Delete a node from list. The node is freed by list_node_free
+ *              after a grace period, so it must not be used by the caller.
+ *****************************************************************************/
+void rculist_node_del( void *pvList, void *pvNode );
+
+/**************************************************************************//**
+ * @fn          rculist_synchronize
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Wait until every node deleted so far has been freed. It must
+ *              not be called from a read section.
+ *****************************************************************************/
+void rculist_synchronize( void *pvList );
+
+/**************************************************************************//**
+ * @fn          rculist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of nodes in the list.
+ * @brief       Get the number of nodes in a list.
+ *****************************************************************************/
+uint32_t rculist_length( void *pvList );
+
+/**************************************************************************//**
+ * @fn          rculist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including all nodes and reader handles. No
+ *              thread may still use the list.
+ *****************************************************************************/
+void rculist_destroy( void *pvList );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RCULIST_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
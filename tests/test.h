@@ -0,0 +1,76 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Minimal checks shared by the tests under tests/
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+/* Stop the test program at the first failed check, later checks would only
+ * trip over the same broken state */
+#define TEST_ASSERT(cond) \
+    do { \
+        if( !(cond) ) { \
+            fprintf( stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #cond ); \
+            exit( 1 ); \
+        } \
+    } while( 0 )
+
+/* Whether misuse is refused. Without the checks of list_inline.h it is
+ * undefined behavior, so the tests skip it. */
+#ifdef LIST_CFG_UNCHECKED
+#define TEST_MISUSE         (0)
+#else
+#define TEST_MISUSE         (1)
+#endif
+
+/* Run one test function and tell which one passed */
+#define TEST_RUN(fn) \
+    do { \
+        fn(); \
+        printf( "  %-32s ok\n", #fn ); \
+    } while( 0 )
+
+#endif /* _TEST_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,193 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_alist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the arena list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "alist.h"
+#include <string.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _MODEL_MAX          (1024)
+#define _ROUNDS             (20000)
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _new_node
+ * @param [in]  pvList - List handle
+ * @param [in]  uiValue - Value of the node
+ * @return      Index of a new node
+ * @brief       Allocate a node holding a value
+ *****************************************************************************/
+static uint32_t _new_node( void *pvList, uint32_t uiValue )
+{
+    uint32_t uiNode = alist_node_alloc( pvList );
+    TEST_ASSERT(uiNode != ALIST_NIL);
+    *(uint32_t *)alist_node_data( pvList, uiNode ) = uiValue;
+    return uiNode;
+}
+
+/**************************************************************************//**
+ * @fn          _check
+ * @param [in]  pvList  - List handle
+ * @param [in]  puiNode - Nodes the list must hold in order
+ * @param [in]  uiCount - Number of nodes
+ * @return      None
+ * @brief       Check a list against a model forwards and backwards, and that
+ *              every node still holds the value set at allocation
+ *****************************************************************************/
+static void _check( void *pvList, const uint32_t *puiNode, uint32_t uiCount )
+{
+    uint32_t uiNode;
+    uint32_t i = 0;
+    TEST_ASSERT(alist_length( pvList ) == uiCount);
+    for( uiNode = alist_node_first( pvList ); uiNode != ALIST_NIL; uiNode = alist_node_next( pvList, uiNode ) ) {
+        TEST_ASSERT(i < uiCount && uiNode == puiNode[i]);
+        TEST_ASSERT(*(uint32_t *)alist_node_data( pvList, uiNode ) == uiNode * 3);
+        i++;
+    }
+    TEST_ASSERT(i == uiCount);
+    for( uiNode = alist_node_last( pvList ); uiNode != ALIST_NIL; uiNode = alist_node_prev( pvList, uiNode ) ) {
+        TEST_ASSERT(i > 0 && uiNode == puiNode[i - 1]);
+        i--;
+    }
+    TEST_ASSERT(i == 0);
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_model
+ * @param       None
+ * @return      None
+ * @brief       Random adds, inserts and deletes agree with an array model
+ *              while the arena grows and recycles freed nodes
+ *****************************************************************************/
+static void test_model( void )
+{
+    static uint32_t s_auiModel[_MODEL_MAX];
+    void *pvList = alist_create( sizeof( uint32_t ), 4 );
+    uint32_t uiCount = 0;
+    uint32_t uiRound;
+    uint32_t uiPos;
+    uint32_t uiNode;
+    TEST_ASSERT(pvList && alist_node_size( pvList ) == sizeof( uint32_t ));
+    TEST_ASSERT(alist_node_first( pvList ) == ALIST_NIL);
+    srand( 19 );
+    for( uiRound = 0; uiRound < _ROUNDS; uiRound++ ) {
+        uiPos = uiCount?((uint32_t)rand() % uiCount):0;
+        if( uiCount == 0 || (uiCount < _MODEL_MAX && rand() % 3) ) {
+            uiNode = alist_node_alloc( pvList );
+            TEST_ASSERT(uiNode != ALIST_NIL);
+            *(uint32_t *)alist_node_data( pvList, uiNode ) = uiNode * 3;
+            switch( rand() % (uiCount?4:2) ) {
+            case 0:
+                alist_add_rear( pvList, uiNode );
+                uiPos = uiCount;
+                break;
+            case 1:
+                alist_add_front( pvList, uiNode );
+                uiPos = 0;
+                break;
+            case 2:
+                alist_insert_before( pvList, s_auiModel[uiPos], uiNode );
+                break;
+            default:
+                alist_insert_after( pvList, s_auiModel[uiPos], uiNode );
+                uiPos++;
+                break;
+            }
+            memmove( &s_auiModel[uiPos + 1], &s_auiModel[uiPos], (uiCount - uiPos) * sizeof( uint32_t ) );
+            s_auiModel[uiPos] = uiNode;
+            uiCount++;
+        } else {
+            uiNode = s_auiModel[uiPos];
+            alist_node_del( pvList, uiNode );
+            alist_node_free( pvList, uiNode );
+            uiCount--;
+            memmove( &s_auiModel[uiPos], &s_auiModel[uiPos + 1], (uiCount - uiPos) * sizeof( uint32_t ) );
+        }
+        if( !(uiRound % 251) ) {
+            _check( pvList, s_auiModel, uiCount );
+        }
+    }
+    _check( pvList, s_auiModel, uiCount );
+    alist_flush( pvList );
+    _check( pvList, NULL, 0 );
+    alist_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_misuse
+ * @param       None
+ * @return      None
+ * @brief       Linked nodes are not linked twice nor freed, and deleting an
+ *              idle node does nothing
+ *****************************************************************************/
+static void test_misuse( void )
+{
+    void *pvList = alist_create( sizeof( uint32_t ), 0 );
+    uint32_t uiA = _new_node( pvList, 0 );
+    uint32_t uiB = _new_node( pvList, 0 );
+    alist_add_rear( pvList, uiA );
+    alist_add_rear( pvList, uiA );
+    alist_add_front( pvList, uiA );
+    TEST_ASSERT(alist_length( pvList ) == 1);
+    alist_node_free( pvList, uiA );
+    TEST_ASSERT(alist_node_first( pvList ) == uiA);
+    alist_node_del( pvList, uiB );
+    TEST_ASSERT(alist_length( pvList ) == 1);
+    alist_insert_after( pvList, uiA, uiB );
+    TEST_ASSERT(alist_node_next( pvList, uiA ) == uiB && alist_node_prev( pvList, uiB ) == uiA);
+    TEST_ASSERT(alist_node_next( pvList, uiB ) == ALIST_NIL);
+    alist_destroy( pvList );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_model);
+    TEST_RUN(test_misuse);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,220 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_easylist.cpp
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the C++ wrapper
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "easylist.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _ALIGNED(p)         (!(reinterpret_cast<uintptr_t>( p ) % easylist::NODE_ALIGN))
+
+/* Type Definitions -------------------------------------------------------- */
+
+/* Element counting its live instances, aligned as strictly as a node allows */
+struct alignas(easylist::NODE_ALIGN) item_t {
+    static int s_iLive;
+
+    int m_iKey;
+    std::string m_sName;
+
+    item_t( int iKey, const char *pcName ) : m_iKey( iKey ), m_sName( pcName ) { s_iLive++; }
+    item_t( const item_t &rOther ) : m_iKey( rOther.m_iKey ), m_sName( rOther.m_sName ) { s_iLive++; }
+    ~item_t() { s_iLive--; }
+    bool operator<( const item_t &rOther ) const { return m_iKey < rOther.m_iKey; }
+};
+
+int item_t::s_iLive = 0;
+
+typedef easylist::List<item_t> heap_list_t;
+typedef easylist::List<item_t, easylist::PoolAllocator<item_t, 4> > pool_list_t;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _keys
+ * @param [in]  rList - List of items
+ * @return      Keys of the items in list order, one digit each
+ * @brief       Spell the keys of a list of items with single digit keys
+ *****************************************************************************/
+template <typename L>
+static std::string _keys( const L &rList )
+{
+    std::string sKeys;
+    for( const item_t &rItem : rList ) {
+        TEST_ASSERT(_ALIGNED(&rItem));
+        sKeys += static_cast<char>( '0' + rItem.m_iKey );
+    }
+    return sKeys;
+}
+
+/**************************************************************************//**
+ * @fn          _fill
+ * @param [in]  rList - List of items
+ * @return      None
+ * @brief       Build the list 3 1 4 0 2 with all the ways of adding
+ *****************************************************************************/
+template <typename L>
+static void _fill( L &rList )
+{
+    rList.emplace_back( 1, "one" );
+    rList.push_back( item_t( 4, "four" ) );
+    rList.emplace_front( 3, "three" );
+    rList.emplace( rList.cend(), 2, "two" );
+    rList.emplace( --rList.cend(), 0, "zero" );
+    TEST_ASSERT(_keys( rList ) == "31402" && rList.size() == 5);
+}
+
+/**************************************************************************//**
+ * @fn          _check
+ * @param [in]  rList - List of items
+ * @return      None
+ * @brief       Erase, sort and walk a list backwards, then clear it
+ *****************************************************************************/
+template <typename L>
+static void _check( L &rList )
+{
+    const L &rConst = rList;
+    typename L::iterator iPos;
+    std::string sKeys;
+    _fill( rList );
+    TEST_ASSERT(item_t::s_iLive == 5);
+    iPos = rList.erase( ++rList.cbegin() );
+    TEST_ASSERT(iPos->m_iKey == 4 && _keys( rList ) == "3402");
+    rList.pop_front();
+    rList.pop_back();
+    TEST_ASSERT(_keys( rList ) == "40" && item_t::s_iLive == 2);
+    rList.emplace_back( 3, "three" );
+    rList.emplace_back( 1, "one" );
+    rList.sort();
+    TEST_ASSERT(_keys( rList ) == "0134");
+    TEST_ASSERT(rList.front().m_sName == "zero" && rList.back().m_sName == "four");
+    for( typename L::const_reverse_iterator iRev = rConst.rbegin(); iRev != rConst.rend(); ++iRev ) {
+        sKeys += static_cast<char>( '0' + iRev->m_iKey );
+    }
+    TEST_ASSERT(sKeys == "4310");
+    rList.clear();
+    TEST_ASSERT(rList.empty() && item_t::s_iLive == 0);
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_heap
+ * @param       None
+ * @return      None
+ * @brief       Add, erase, sort and iterate with nodes of list_node_alloc
+ *****************************************************************************/
+static void test_heap( void )
+{
+    heap_list_t sList;
+    _check( sList );
+}
+
+/**************************************************************************//**
+ * @fn          test_pool
+ * @param       None
+ * @return      None
+ * @brief       The same with nodes of a pool spanning several chunks
+ *****************************************************************************/
+static void test_pool( void )
+{
+    pool_list_t sList;
+    int i;
+    _check( sList );
+    for( i = 0; i < 10; i++ ) {
+        sList.emplace_front( i, "many" );
+    }
+    TEST_ASSERT(_keys( sList ) == "9876543210" && item_t::s_iLive == 10);
+}
+
+/**************************************************************************//**
+ * @fn          test_move
+ * @param       None
+ * @return      None
+ * @brief       Moving a list hands over its elements and allocator, and the
+ *              moved from list can still be destroyed
+ *****************************************************************************/
+static void test_move( void )
+{
+    {
+        heap_list_t sA;
+        _fill( sA );
+        heap_list_t sB( std::move( sA ) );
+        TEST_ASSERT(_keys( sB ) == "31402" && item_t::s_iLive == 5);
+        heap_list_t sC;
+        sC.emplace_back( 9, "nine" );
+        sC = std::move( sB );
+        TEST_ASSERT(_keys( sC ) == "31402" && item_t::s_iLive == 6);
+        for( heap_list_t::reverse_iterator iRev = sC.rbegin(); iRev != sC.rend(); ++iRev ) {
+            iRev->m_iKey++;
+        }
+        TEST_ASSERT(_keys( sC ) == "42513");
+    }
+    TEST_ASSERT(item_t::s_iLive == 0);
+    {
+        pool_list_t sA;
+        _fill( sA );
+        pool_list_t sB( std::move( sA ) );
+        pool_list_t sC;
+        sC.emplace_back( 9, "nine" );
+        sC = std::move( sB );
+        TEST_ASSERT(_keys( sC ) == "31402" && item_t::s_iLive == 6);
+        sC.emplace_back( 5, "five" );
+        sC.sort();
+        TEST_ASSERT(_keys( sC ) == "012345");
+    }
+    TEST_ASSERT(item_t::s_iLive == 0);
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_heap);
+    TEST_RUN(test_pool);
+    TEST_RUN(test_move);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,799 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_list.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the core list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "list.h"
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stddef.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _NODES              (1000)
+#define _CACHE_THREADS      (4)
+#define _ALIGNED(p)         (!((uintptr_t)(p) % _Alignof(max_align_t)))
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _ITEM_T {
+    int m_iValue;
+    node_head_t m_stLink;
+} item_t;
+
+typedef struct _REC_T {
+    int m_iKey;
+    int m_iSeq;
+} rec_t;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _new_int
+ * @param [in]  iValue - Value of the node
+ * @return      Pointer to a new node holding an int
+ * @brief       Allocate a node holding an int
+ *****************************************************************************/
+static int *_new_int( int iValue )
+{
+    int *piNode = list_node_alloc( sizeof( int ) );
+    TEST_ASSERT(piNode);
+    *piNode = iValue;
+    return piNode;
+}
+
+/**************************************************************************//**
+ * @fn          _expect
+ * @param [in]  pvList   - List handle
+ * @param [in]  piValues - Values the list must hold in order
+ * @param [in]  uiCount  - Number of values
+ * @return      None
+ * @brief       Check a list of ints forwards, backwards and by its length
+ *****************************************************************************/
+static void _expect( void *pvList, const int *piValues, uint32_t uiCount )
+{
+    int *piNode;
+    uint32_t i = 0;
+    TEST_ASSERT(list_length( pvList ) == uiCount);
+    for( piNode = list_node_first( pvList ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(i < uiCount && *piNode == piValues[i]);
+        i++;
+    }
+    TEST_ASSERT(i == uiCount);
+    for( piNode = list_node_last( pvList ); piNode; piNode = list_node_prev( piNode ) ) {
+        TEST_ASSERT(i > 0 && *piNode == piValues[i - 1]);
+        i--;
+    }
+    TEST_ASSERT(i == 0);
+}
+
+/**************************************************************************//**
+ * @fn          _cmp_int
+ * @param [in]  pvA - Pointer to an int node
+ * @param [in]  pvB - Pointer to an int node
+ * @return      Order of the two values
+ * @brief       Compare two int nodes
+ *****************************************************************************/
+static int _cmp_int( const void *pvA, const void *pvB )
+{
+    return (*(const int *)pvA > *(const int *)pvB) - (*(const int *)pvA < *(const int *)pvB);
+}
+
+/**************************************************************************//**
+ * @fn          _cmp_rec
+ * @param [in]  pvA - Pointer to a record node
+ * @param [in]  pvB - Pointer to a record node
+ * @return      Order of the two keys
+ * @brief       Compare two record nodes by key only
+ *****************************************************************************/
+static int _cmp_rec( const void *pvA, const void *pvB )
+{
+    return (((const rec_t *)pvA)->m_iKey > ((const rec_t *)pvB)->m_iKey)
+           - (((const rec_t *)pvA)->m_iKey < ((const rec_t *)pvB)->m_iKey);
+}
+
+/**************************************************************************//**
+ * @fn          _sum_visit
+ * @param [in]  pvNode - Pointer to an int node
+ * @param [in]  pvCtx  - Pointer to the running sum, stop at a negative node
+ * @return      Non-zero to stop the walk
+ * @brief       Visitor summing the values of a walk
+ *****************************************************************************/
+static int _sum_visit( void *pvNode, void *pvCtx )
+{
+    if( *(int *)pvNode < 0 ) {
+        return 1;
+    }
+    *(long *)pvCtx = *(long *)pvCtx * 10 + *(int *)pvNode;
+    return 0;
+}
+
+/**************************************************************************//**
+ * @fn          _free_visit
+ * @param [in]  pvNode - Pointer to a node
+ * @param [in]  pvCtx  - Unused
+ * @return      0
+ * @brief       Visitor deleting and freeing the node it is given
+ *****************************************************************************/
+static int _free_visit( void *pvNode, void *pvCtx )
+{
+    (void)pvCtx;
+    list_node_del( pvNode );
+    list_node_free( pvNode );
+    return 0;
+}
+
+/**************************************************************************//**
+ * @fn          _batch_visit
+ * @param [in]  ppvNodes - Nodes of the batch
+ * @param [in]  uiCount  - Number of nodes
+ * @param [in]  pvCtx    - Pointer to the next expected value
+ * @return      0
+ * @brief       Visitor checking batches are in order and not too large
+ *****************************************************************************/
+static int _batch_visit( void **ppvNodes, uint32_t uiCount, void *pvCtx )
+{
+    uint32_t i;
+    TEST_ASSERT(uiCount > 0 && uiCount <= 16);
+    for( i = 0; i < uiCount; i++ ) {
+        TEST_ASSERT(*(int *)ppvNodes[i] == *(int *)pvCtx);
+        (*(int *)pvCtx)++;
+    }
+    return 0;
+}
+
+/**************************************************************************//**
+ * @fn          _is_even
+ * @param [in]  pvNode - Pointer to an int node
+ * @param [in]  pvCtx  - Unused
+ * @return      true for an even value
+ * @brief       Predicate of list_remove_if
+ *****************************************************************************/
+static bool _is_even( const void *pvNode, void *pvCtx )
+{
+    (void)pvCtx;
+    return !(*(const int *)pvNode & 1);
+}
+
+/* Nodes of the compaction test, kept up to date by _relocate */
+static int *s_apiNode[_NODES];
+
+/**************************************************************************//**
+ * @fn          _relocate
+ * @param [in]  pvOld - Old address of a node
+ * @param [in]  pvNew - New address of the node
+ * @return      None
+ * @brief       Follow a node moved by list_compact
+ *****************************************************************************/
+static void _relocate( void *pvOld, void *pvNew )
+{
+    TEST_ASSERT(*(int *)pvOld == *(int *)pvNew);
+    TEST_ASSERT(s_apiNode[*(int *)pvNew] == pvOld);
+    s_apiNode[*(int *)pvNew] = pvNew;
+}
+
+/**************************************************************************//**
+ * @fn          _cache_worker
+ * @param [in]  pvArg - Unused
+ * @return      NULL
+ * @brief       Allocate and free nodes of mixed sizes through the node cache
+ *****************************************************************************/
+static void *_cache_worker( void *pvArg )
+{
+    void *apvNode[256];
+    uint32_t uiRound;
+    uint32_t i;
+    (void)pvArg;
+    for( uiRound = 0; uiRound < 200; uiRound++ ) {
+        for( i = 0; i < 256; i++ ) {
+            apvNode[i] = list_node_alloc( 8 + (i * 37) % 3000 );
+            TEST_ASSERT(apvNode[i]);
+            memset( apvNode[i], (int)i, list_node_size( apvNode[i] ) );
+        }
+        for( i = 0; i < 256; i++ ) {
+            TEST_ASSERT(*(uint8_t *)apvNode[i] == (uint8_t)i);
+            list_node_free( apvNode[i] );
+        }
+    }
+    return NULL;
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_basic
+ * @param       None
+ * @return      None
+ * @brief       Add, insert, delete and swap nodes, and refuse misuse
+ *****************************************************************************/
+static void test_basic( void )
+{
+    void *pvList = list_create();
+    void *pvOther = list_create();
+    int *piA = _new_int( 1 );
+    int *piB = _new_int( 2 );
+    int *piC = _new_int( 3 );
+    int *piD = _new_int( 4 );
+    TEST_ASSERT(pvList && pvOther);
+    TEST_ASSERT(!list_node_first( pvList ) && !list_node_last( pvList ));
+    list_add_rear( pvList, piB );
+    list_add_front( pvList, piA );
+    list_add_rear( pvList, piD );
+    list_insert_before( piD, piC );
+    _expect( pvList, (int []){ 1, 2, 3, 4 }, 4 );
+    /* A used node can not be added twice */
+    if( TEST_MISUSE ) {
+        list_add_rear( pvOther, piA );
+        TEST_ASSERT(list_length( pvOther ) == 0);
+    }
+    list_node_swap( piA, piD );
+    _expect( pvList, (int []){ 4, 2, 3, 1 }, 4 );
+    list_node_swap( piB, piC );
+    _expect( pvList, (int []){ 4, 3, 2, 1 }, 4 );
+    list_node_del( piC );
+    if( TEST_MISUSE ) {
+        list_node_del( piC );
+    }
+    _expect( pvList, (int []){ 4, 2, 1 }, 3 );
+    ilst_insert_after( piD, piC );
+    _expect( pvList, (int []){ 4, 3, 2, 1 }, 4 );
+    /* Swapping across lists moves both nodes */
+    list_node_del( piA );
+    list_add_rear( pvOther, piA );
+    list_node_swap( piC, piA );
+    _expect( pvList, (int []){ 4, 1, 2 }, 3 );
+    _expect( pvOther, (int []){ 3 }, 1 );
+    TEST_ASSERT(list_node_size( piA ) == sizeof( int ));
+    list_destroy( pvOther );
+    list_flush( pvList );
+    _expect( pvList, NULL, 0 );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_pool
+ * @param       None
+ * @return      None
+ * @brief       A pool backed list takes only its own nodes and gives all of
+ *              them back on flush, so refilling it reuses the same memory
+ *****************************************************************************/
+static void test_pool( void )
+{
+    void *pvPool = list_pool_create( sizeof( int ), 64 );
+    void *pvList = list_create_from( pvPool );
+    void *apvSeen[_NODES];
+    void *pvNode;
+    uint32_t uiSeen = 0;
+    uint32_t i;
+    uint32_t j;
+    TEST_ASSERT(pvPool && pvList);
+    if( TEST_MISUSE ) {
+        pvNode = list_node_alloc( sizeof( int ) );
+        list_add_rear( pvList, pvNode );
+        TEST_ASSERT(list_length( pvList ) == 0);
+        list_node_free( pvNode );
+    }
+    for( i = 0; i < _NODES; i++ ) {
+        pvNode = list_node_alloc_from( pvPool );
+        TEST_ASSERT(pvNode && list_node_size( pvNode ) == sizeof( int ));
+        *(int *)pvNode = (int)i;
+        apvSeen[uiSeen++] = pvNode;
+        list_add_rear( pvList, pvNode );
+    }
+    TEST_ASSERT(list_length( pvList ) == _NODES);
+    list_flush( pvList );
+    TEST_ASSERT(list_length( pvList ) == 0 && !list_node_first( pvList ));
+    for( i = 0; i < _NODES; i++ ) {
+        pvNode = list_node_alloc_from( pvPool );
+        for( j = 0; j < uiSeen && apvSeen[j] != pvNode; j++ ) {
+        }
+        TEST_ASSERT(j < uiSeen);
+        list_add_front( pvList, pvNode );
+    }
+    list_destroy( pvList );
+    list_pool_destroy( pvPool );
+}
+
+/**************************************************************************//**
+ * @fn          test_links
+ * @param       None
+ * @return      None
+ * @brief       Embedded links work as nodes and are never freed by the list
+ *****************************************************************************/
+static void test_links( void )
+{
+    item_t astItem[8];
+    void *pvList = list_create();
+    void *pvNode;
+    uint32_t i;
+    for( i = 0; i < 8; i++ ) {
+        astItem[i].m_iValue = (int)i;
+        pvNode = list_link_init( &astItem[i].m_stLink );
+        TEST_ASSERT(pvNode == LIST_LINK_TO_NODE(&astItem[i].m_stLink));
+        list_add_rear( pvList, pvNode );
+    }
+    i = 0;
+    for( pvNode = list_node_first( pvList ); pvNode; pvNode = list_node_next( pvNode ) ) {
+        TEST_ASSERT(LIST_CONTAINER_OF(pvNode, item_t, m_stLink) == &astItem[i]);
+        i++;
+    }
+    TEST_ASSERT(i == 8);
+    TEST_ASSERT(!list_node_resize( LIST_LINK_TO_NODE(&astItem[0].m_stLink), 64 ));
+    TEST_ASSERT(!list_clone( pvList ));
+    list_flush( pvList );
+    TEST_ASSERT(list_length( pvList ) == 0);
+    /* Flushed links are idle again and can be reused */
+    list_add_rear( pvList, LIST_LINK_TO_NODE(&astItem[3].m_stLink) );
+    TEST_ASSERT(list_length( pvList ) == 1);
+    list_destroy( pvList );
+    TEST_ASSERT(astItem[3].m_iValue == 3);
+}
+
+/**************************************************************************//**
+ * @fn          test_sort
+ * @param       None
+ * @return      None
+ * @brief       Both sorts order the list and keep equal nodes in order
+ *****************************************************************************/
+static void test_sort( void )
+{
+    void *pvList;
+    rec_t *psRec;
+    rec_t *psPrev;
+    uint32_t uiThreads;
+    uint32_t i;
+    for( uiThreads = 1; uiThreads <= 4; uiThreads += 3 ) {
+        pvList = list_create();
+        srand( 7 );
+        for( i = 0; i < 10 * _NODES; i++ ) {
+            psRec = list_node_alloc( sizeof( rec_t ) );
+            psRec->m_iKey = rand() % 100;
+            psRec->m_iSeq = (int)i;
+            list_add_rear( pvList, psRec );
+        }
+        if( uiThreads == 1 ) {
+            list_sort( pvList, _cmp_rec );
+        } else {
+            list_sort_parallel( pvList, _cmp_rec, uiThreads );
+        }
+        TEST_ASSERT(list_length( pvList ) == 10 * _NODES);
+        psPrev = list_node_first( pvList );
+        for( psRec = list_node_next( psPrev ); psRec; psRec = list_node_next( psRec ) ) {
+            TEST_ASSERT(psPrev->m_iKey < psRec->m_iKey
+                        || (psPrev->m_iKey == psRec->m_iKey && psPrev->m_iSeq < psRec->m_iSeq));
+            TEST_ASSERT(list_node_prev( psRec ) == psPrev);
+            psPrev = psRec;
+        }
+        TEST_ASSERT(list_node_last( pvList ) == psPrev);
+        list_destroy( pvList );
+    }
+    pvList = list_create();
+    list_sort( pvList, _cmp_int );
+    list_add_rear( pvList, _new_int( 5 ) );
+    list_sort( pvList, _cmp_int );
+    _expect( pvList, (int []){ 5 }, 1 );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_splice
+ * @param       None
+ * @return      None
+ * @brief       Splice, concat and split keep lengths and owners right, with
+ *              and without owner tracking
+ *****************************************************************************/
+static void test_splice( void )
+{
+    uint32_t uiOptions;
+    void *pvA;
+    void *pvB;
+    void *pvC;
+    int *apiNode[10];
+    int i;
+    for( uiOptions = 0; uiOptions <= LIST_OPT_NO_OWNER; uiOptions += LIST_OPT_NO_OWNER ) {
+        pvA = list_create_ex( NULL, uiOptions );
+        pvB = list_create_ex( NULL, uiOptions );
+        for( i = 0; i < 10; i++ ) {
+            apiNode[i] = _new_int( i );
+            list_add_rear( (i < 6)?pvA:pvB, apiNode[i] );
+        }
+        list_splice( pvB, apiNode[7], apiNode[1], apiNode[3] );
+        _expect( pvA, (int []){ 0, 4, 5 }, 3 );
+        _expect( pvB, (int []){ 6, 1, 2, 3, 7, 8, 9 }, 7 );
+        /* Within one list */
+        list_splice( pvB, NULL, apiNode[6], apiNode[2] );
+        _expect( pvB, (int []){ 3, 7, 8, 9, 6, 1, 2 }, 7 );
+        list_splice( pvB, apiNode[3], apiNode[9], apiNode[9] );
+        _expect( pvB, (int []){ 9, 3, 7, 8, 6, 1, 2 }, 7 );
+        /* An end of the range is no position for it */
+        list_splice( pvB, apiNode[8], apiNode[3], apiNode[8] );
+        _expect( pvB, (int []){ 9, 3, 7, 8, 6, 1, 2 }, 7 );
+        list_concat( pvA, pvB );
+        _expect( pvA, (int []){ 0, 4, 5, 9, 3, 7, 8, 6, 1, 2 }, 10 );
+        _expect( pvB, NULL, 0 );
+        /* Nodes moved to another list now belong to it */
+        list_node_del( apiNode[9] );
+        _expect( pvA, (int []){ 0, 4, 5, 3, 7, 8, 6, 1, 2 }, 9 );
+        list_add_front( pvB, apiNode[9] );
+        pvC = list_split_after( pvA, apiNode[7] );
+        TEST_ASSERT(pvC);
+        _expect( pvA, (int []){ 0, 4, 5, 3, 7 }, 5 );
+        _expect( pvC, (int []){ 8, 6, 1, 2 }, 4 );
+        list_node_del( apiNode[1] );
+        _expect( pvC, (int []){ 8, 6, 2 }, 3 );
+        list_node_free( apiNode[1] );
+        list_destroy( pvA );
+        list_destroy( pvB );
+        list_destroy( pvC );
+    }
+}
+
+/**************************************************************************//**
+ * @fn          test_walk
+ * @param       None
+ * @return      None
+ * @brief       Walks visit every node in order, stop when told and let the
+ *              visitor free its node
+ *****************************************************************************/
+static void test_walk( void )
+{
+    void *pvList = list_create();
+    long lSum = 0;
+    int iNext = 1;
+    int i;
+    for( i = 1; i <= 5; i++ ) {
+        list_add_rear( pvList, _new_int( i ) );
+    }
+    list_for_each( pvList, _sum_visit, &lSum );
+    TEST_ASSERT(lSum == 12345);
+    lSum = 0;
+    list_for_each_reverse( pvList, _sum_visit, &lSum );
+    TEST_ASSERT(lSum == 54321);
+    list_insert_before( list_node_at( pvList, 3 ), _new_int( -1 ) );
+    lSum = 0;
+    list_for_each( pvList, _sum_visit, &lSum );
+    TEST_ASSERT(lSum == 123);
+    list_for_each( pvList, _free_visit, NULL );
+    TEST_ASSERT(list_length( pvList ) == 0);
+    for( i = 1; i <= 100; i++ ) {
+        list_add_rear( pvList, _new_int( i ) );
+    }
+    list_for_each_batch( pvList, _batch_visit, &iNext );
+    TEST_ASSERT(iNext == 101);
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_batch
+ * @param       None
+ * @return      None
+ * @brief       Batch allocation and insert, remove_if and clone
+ *****************************************************************************/
+static void test_batch( void )
+{
+    void *apvNode[100];
+    void *pvList = list_create();
+    void *pvCopy;
+    int *piNode;
+    int *piCopy;
+    uint32_t i;
+    TEST_ASSERT(list_alloc_batch( sizeof( int ), 100, apvNode ));
+    for( i = 0; i < 100; i++ ) {
+        *(int *)apvNode[i] = (int)i;
+    }
+    TEST_ASSERT(list_add_rear_batch( pvList, apvNode, 100 ) == 100);
+    TEST_ASSERT(list_add_rear_batch( pvList, apvNode, 100 ) == 0);
+    TEST_ASSERT(list_length( pvList ) == 100);
+    pvCopy = list_clone( pvList );
+    TEST_ASSERT(pvCopy && list_length( pvCopy ) == 100);
+    TEST_ASSERT(list_remove_if( pvList, _is_even, NULL ) == 50);
+    TEST_ASSERT(list_length( pvList ) == 50);
+    i = 1;
+    for( piNode = list_node_first( pvList ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(*piNode == (int)i);
+        i += 2;
+    }
+    /* The copy is untouched and independent */
+    i = 0;
+    piNode = list_node_first( pvList );
+    for( piCopy = list_node_first( pvCopy ); piCopy; piCopy = list_node_next( piCopy ) ) {
+        TEST_ASSERT(*piCopy == (int)i && piCopy != piNode);
+        i++;
+    }
+    TEST_ASSERT(i == 100);
+    list_destroy( pvList );
+    list_destroy( pvCopy );
+}
+
+/**************************************************************************//**
+ * @fn          test_resize
+ * @param       None
+ * @return      None
+ * @brief       A resized node keeps its place and its data
+ *****************************************************************************/
+static void test_resize( void )
+{
+    void *pvList = list_create();
+    int *piNode;
+    int i;
+    for( i = 0; i < 3; i++ ) {
+        list_add_rear( pvList, _new_int( i ) );
+    }
+    piNode = list_node_resize( list_node_at( pvList, 1 ), 4096 );
+    TEST_ASSERT(piNode && *piNode == 1 && list_node_size( piNode ) == 4096);
+    piNode[1023] = 7;
+    TEST_ASSERT(list_node_index( piNode ) == 1);
+    piNode = list_node_resize( piNode, sizeof( int ) );
+    TEST_ASSERT(piNode && *piNode == 1 && list_node_size( piNode ) == sizeof( int ));
+    _expect( pvList, (int []){ 0, 1, 2 }, 3 );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_compact
+ * @param       None
+ * @return      None
+ * @brief       Compaction lays nodes out in list order and reports each move
+ *****************************************************************************/
+static void test_compact( void )
+{
+    void *pvList = list_create();
+    int *piNode;
+    int *piPrev = NULL;
+    void *pvFrom;
+    uint32_t i;
+    for( i = 0; i < _NODES; i++ ) {
+        s_apiNode[i] = _new_int( (int)i );
+        list_add_front( pvList, s_apiNode[i] );
+    }
+    TEST_ASSERT(list_compact( pvList, _relocate ));
+    for( piNode = list_node_first( pvList ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(s_apiNode[*piNode] == piNode);
+        TEST_ASSERT(!piPrev || (uint8_t *)piNode > (uint8_t *)piPrev);
+        piPrev = piNode;
+    }
+    list_sort( pvList, _cmp_int );
+    for( pvFrom = NULL; (pvFrom = list_compact_step( pvList, pvFrom, 100, _relocate )); ) {
+    }
+    i = 0;
+    for( piNode = list_node_first( pvList ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(*piNode == (int)i && s_apiNode[i] == piNode);
+        i++;
+    }
+    TEST_ASSERT(i == _NODES);
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_image
+ * @param       None
+ * @return      None
+ * @brief       A saved list maps back read-only with the same nodes, also
+ *              away from its preferred address, and broken images are refused
+ *****************************************************************************/
+static void test_image( void )
+{
+    char acPath[] = "/tmp/easylist_test_XXXXXX";
+    void *pvList = list_create();
+    void *pvMap;
+    void *pvOther;
+    void *pvLink;
+    void *pvBad;
+    off_t lSize;
+    off_t lLast;
+    int *piNode;
+    int iFd;
+    int i;
+    for( i = 0; i < _NODES; i++ ) {
+        list_add_rear( pvList, _new_int( i ) );
+    }
+    iFd = mkstemp( acPath );
+    TEST_ASSERT(iFd >= 0);
+    TEST_ASSERT(list_save( pvList, iFd ));
+    pvMap = list_map( acPath );
+    /* The second mapping can not take the same address and is fixed up */
+    pvOther = list_map( acPath );
+    TEST_ASSERT(pvMap && list_length( pvMap ) == _NODES);
+    TEST_ASSERT(pvOther && list_length( pvOther ) == _NODES);
+    i = 0;
+    for( piNode = list_node_first( pvMap ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(*piNode == i);
+        i++;
+    }
+    TEST_ASSERT(i == _NODES);
+    for( piNode = list_node_last( pvOther ); piNode; piNode = list_node_prev( piNode ) ) {
+        i--;
+        TEST_ASSERT(*piNode == i);
+    }
+    TEST_ASSERT(i == 0);
+    list_destroy( pvOther );
+    /* A broken link or a truncated file is refused */
+    lSize = lseek( iFd, 0, SEEK_END );
+    lLast = lSize - (off_t)((sizeof( node_head_t ) + sizeof( int ) + 15) & ~(size_t)15);
+    TEST_ASSERT(pread( iFd, &pvLink, sizeof( pvLink ), lLast ) == sizeof( pvLink ));
+    pvBad = (char *)pvLink + sizeof( void * );
+    TEST_ASSERT(pwrite( iFd, &pvBad, sizeof( pvBad ), lLast ) == sizeof( pvBad ));
+    TEST_ASSERT(!list_map( acPath ));
+    TEST_ASSERT(pwrite( iFd, &pvLink, sizeof( pvLink ), lLast ) == sizeof( pvLink ));
+    TEST_ASSERT(!ftruncate( iFd, lLast ));
+    TEST_ASSERT(!list_map( acPath ));
+    close( iFd );
+    unlink( acPath );
+    /* Changes are refused */
+    piNode = _new_int( -1 );
+    list_add_rear( pvMap, piNode );
+    list_node_del( list_node_first( pvMap ) );
+    list_flush( pvMap );
+    TEST_ASSERT(list_length( pvMap ) == _NODES);
+    list_node_free( piNode );
+    list_destroy( pvMap );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_cache
+ * @param       None
+ * @return      None
+ * @brief       The node cache serves several threads and can be switched off
+ *              while its nodes are still around
+ *****************************************************************************/
+static void test_cache( void )
+{
+    pthread_t asThread[_CACHE_THREADS];
+    void *pvKept;
+    void *pvList;
+    int *piNode;
+    uint32_t i;
+    list_node_cache_enable( true );
+    pvKept = list_node_alloc( 100 );
+    TEST_ASSERT(pvKept);
+    for( i = 0; i < _CACHE_THREADS; i++ ) {
+        TEST_ASSERT(!pthread_create( &asThread[i], NULL, _cache_worker, NULL ));
+    }
+    for( i = 0; i < _CACHE_THREADS; i++ ) {
+        pthread_join( asThread[i], NULL );
+    }
+    /* remove_if hands cached nodes of two size classes back in bulk, more
+     * than two magazines of each, and the cache serves them again */
+    pvList = list_create();
+    for( i = 0; i < 1000; i++ ) {
+        piNode = list_node_alloc( (i & 2)?sizeof( int ):200 );
+        TEST_ASSERT(piNode);
+        *piNode = (int)i;
+        list_add_rear( pvList, piNode );
+    }
+    TEST_ASSERT(list_remove_if( pvList, _is_even, NULL ) == 500);
+    TEST_ASSERT(list_length( pvList ) == 500);
+    for( i = 0; i < 500; i++ ) {
+        piNode = list_node_alloc( (i & 1)?sizeof( int ):200 );
+        TEST_ASSERT(piNode);
+        *piNode = 0;
+        list_add_rear( pvList, piNode );
+    }
+    TEST_ASSERT(list_remove_if( pvList, _is_even, NULL ) == 500);
+    TEST_ASSERT(list_length( pvList ) == 500);
+    list_destroy( pvList );
+    list_node_cache_enable( false );
+    list_node_free( pvKept );
+    _cache_worker( NULL );
+}
+
+/**************************************************************************//**
+ * @fn          test_align
+ * @param       None
+ * @return      None
+ * @brief       Every kind of node keeps the alignment of malloc for its user
+ *              data field
+ *****************************************************************************/
+static void test_align( void )
+{
+    char acPath[] = "/tmp/easylist_test_XXXXXX";
+    void *pvPool = list_pool_create( 3, 16 );
+    void *pvList = list_create();
+    void *apvNode[8];
+    void *pvCopy;
+    void *pvMap;
+    void *pvNode;
+    uint32_t i;
+    int iFd;
+    for( i = 1; i <= 8; i++ ) {
+        pvNode = list_node_alloc( i * 5 );
+        TEST_ASSERT(_ALIGNED(pvNode));
+        list_add_rear( pvList, pvNode );
+        pvNode = list_node_alloc_from( pvPool );
+        TEST_ASSERT(_ALIGNED(pvNode));
+        list_node_free( pvNode );
+    }
+    list_node_cache_enable( true );
+    for( i = 1; i <= 8; i++ ) {
+        pvNode = list_node_alloc( i * 5 );
+        TEST_ASSERT(_ALIGNED(pvNode));
+        list_add_rear( pvList, pvNode );
+    }
+    list_node_cache_enable( false );
+    TEST_ASSERT(list_alloc_batch( 5, 8, apvNode ));
+    for( i = 0; i < 8; i++ ) {
+        TEST_ASSERT(_ALIGNED(apvNode[i]));
+    }
+    TEST_ASSERT(list_add_rear_batch( pvList, apvNode, 8 ) == 8);
+    pvCopy = list_clone( pvList );
+    TEST_ASSERT(list_compact( pvList, NULL ));
+    iFd = mkstemp( acPath );
+    TEST_ASSERT(iFd >= 0 && list_save( pvList, iFd ));
+    close( iFd );
+    pvMap = list_map( acPath );
+    unlink( acPath );
+    TEST_ASSERT(pvCopy && pvMap);
+    for( pvNode = list_node_first( pvList ); pvNode; pvNode = list_node_next( pvNode ) ) {
+        TEST_ASSERT(_ALIGNED(pvNode));
+    }
+    for( pvNode = list_node_first( pvCopy ); pvNode; pvNode = list_node_next( pvNode ) ) {
+        TEST_ASSERT(_ALIGNED(pvNode));
+    }
+    for( pvNode = list_node_first( pvMap ); pvNode; pvNode = list_node_next( pvNode ) ) {
+        TEST_ASSERT(_ALIGNED(pvNode));
+    }
+    list_destroy( pvMap );
+    list_destroy( pvCopy );
+    list_destroy( pvList );
+    list_pool_destroy( pvPool );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_basic);
+    TEST_RUN(test_pool);
+    TEST_RUN(test_links);
+    TEST_RUN(test_sort);
+    TEST_RUN(test_splice);
+    TEST_RUN(test_walk);
+    TEST_RUN(test_batch);
+    TEST_RUN(test_resize);
+    TEST_RUN(test_compact);
+    TEST_RUN(test_image);
+    TEST_RUN(test_cache);
+    TEST_RUN(test_align);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
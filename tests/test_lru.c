@@ -0,0 +1,215 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_lru.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the LRU cache
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "lru.h"
+#include <string.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _CAPACITY           (64)
+#define _KEYS               (200)
+#define _ROUNDS             (50000)
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _ENTRY_T {
+    int m_iKey;
+    int m_iValue;
+} entry_t;
+
+/* Local Variables --------------------------------------------------------- */
+
+/* Keys from the least to the most recently used one */
+static int s_aiModel[_CAPACITY];
+static uint32_t s_uiModel;
+
+/* Value last put for each key */
+static int s_aiValue[_KEYS];
+static int s_iEvicted;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _key
+ * @param [in]  pvData - Pointer to an entry
+ * @return      Pointer to the key of the entry
+ * @brief       Key function of the cache
+ *****************************************************************************/
+static const void *_key( const void *pvData )
+{
+    return &((const entry_t *)pvData)->m_iKey;
+}
+
+/**************************************************************************//**
+ * @fn          _hash
+ * @param [in]  pvKey - Pointer to an int key
+ * @return      Hash of the key
+ * @brief       Hash function of the cache
+ *****************************************************************************/
+static uint32_t _hash( const void *pvKey )
+{
+    return (uint32_t)*(const int *)pvKey * 2654435761u;
+}
+
+/**************************************************************************//**
+ * @fn          _eq
+ * @param [in]  pvKeyA - Pointer to an int key
+ * @param [in]  pvKeyB - Pointer to an int key
+ * @return      true if the keys are equal
+ * @brief       Equality function of the cache
+ *****************************************************************************/
+static bool _eq( const void *pvKeyA, const void *pvKeyB )
+{
+    return *(const int *)pvKeyA == *(const int *)pvKeyB;
+}
+
+/**************************************************************************//**
+ * @fn          _evict
+ * @param [in]  pvData - Pointer to the evicted entry
+ * @return      None
+ * @brief       Eviction callback recording the key
+ *****************************************************************************/
+static void _evict( void *pvData )
+{
+    TEST_ASSERT(s_iEvicted < 0);
+    s_iEvicted = ((entry_t *)pvData)->m_iKey;
+}
+
+/**************************************************************************//**
+ * @fn          _model_find
+ * @param [in]  iKey - Key to look for
+ * @return      Index of the key in the model or s_uiModel if absent
+ * @brief       Look a key up in the model
+ *****************************************************************************/
+static uint32_t _model_find( int iKey )
+{
+    uint32_t i;
+    for( i = 0; i < s_uiModel && s_aiModel[i] != iKey; i++ ) {
+    }
+    return i;
+}
+
+/**************************************************************************//**
+ * @fn          _model_drop
+ * @param [in]  uiPos - Index of a key in the model
+ * @return      None
+ * @brief       Remove a key from the model
+ *****************************************************************************/
+static void _model_drop( uint32_t uiPos )
+{
+    s_uiModel--;
+    memmove( &s_aiModel[uiPos], &s_aiModel[uiPos + 1], (s_uiModel - uiPos) * sizeof( int ) );
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_model
+ * @param       None
+ * @return      None
+ * @brief       Hits, misses, overwrites, evictions and removals agree with a
+ *              recency ordered model
+ *****************************************************************************/
+static void test_model( void )
+{
+    void *pvLru = lru_create( _CAPACITY, sizeof( entry_t ), _key, _hash, _eq, _evict );
+    entry_t stEntry;
+    entry_t *psEntry;
+    uint32_t uiRound;
+    uint32_t uiPos;
+    int iKey;
+    TEST_ASSERT(pvLru);
+    srand( 29 );
+    for( uiRound = 0; uiRound < _ROUNDS; uiRound++ ) {
+        iKey = rand() % _KEYS;
+        uiPos = _model_find( iKey );
+        s_iEvicted = -1;
+        switch( rand() % 5 ) {
+        case 0:
+        case 1:
+            psEntry = lru_get( pvLru, &iKey );
+            if( uiPos == s_uiModel ) {
+                TEST_ASSERT(!psEntry);
+                break;
+            }
+            TEST_ASSERT(psEntry && psEntry->m_iKey == iKey && psEntry->m_iValue == s_aiValue[iKey]);
+            _model_drop( uiPos );
+            s_aiModel[s_uiModel++] = iKey;
+            break;
+        case 2:
+            TEST_ASSERT(lru_remove( pvLru, &iKey ) == (uiPos < s_uiModel));
+            if( uiPos < s_uiModel ) {
+                _model_drop( uiPos );
+            }
+            break;
+        default:
+            stEntry.m_iKey = iKey;
+            stEntry.m_iValue = (int)uiRound;
+            s_aiValue[iKey] = (int)uiRound;
+            psEntry = lru_put( pvLru, &stEntry );
+            TEST_ASSERT(psEntry && psEntry->m_iKey == iKey && psEntry->m_iValue == (int)uiRound);
+            if( uiPos < s_uiModel ) {
+                _model_drop( uiPos );
+            } else if( s_uiModel == _CAPACITY ) {
+                TEST_ASSERT(s_iEvicted == s_aiModel[0]);
+                _model_drop( 0 );
+            }
+            s_aiModel[s_uiModel++] = iKey;
+            break;
+        }
+        if( s_iEvicted >= 0 ) {
+            TEST_ASSERT(s_aiModel[s_uiModel - 1] == iKey && _model_find( s_iEvicted ) == s_uiModel);
+        }
+        TEST_ASSERT(lru_length( pvLru ) == s_uiModel);
+    }
+    lru_destroy( pvLru );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_model);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
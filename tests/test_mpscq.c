@@ -0,0 +1,245 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_mpscq.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior and stress checks of the multi-producer single-
+ *              consumer queue
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "mpscq.h"
+#include <pthread.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _PRODUCERS          (4)
+#define _MESSAGES           (100000)
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _MSG_T {
+    uint32_t m_uiProducer;
+    uint32_t m_uiSeq;
+} msg_t;
+
+typedef struct _PRODUCER_T {
+    pthread_t m_sThread;
+    void *m_pvQueue;
+    uint32_t m_uiId;
+} producer_t;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _produce
+ * @param [in]  pvArg - Pointer to the producer
+ * @return      NULL
+ * @brief       Enqueue numbered messages as fast as possible
+ *****************************************************************************/
+static void *_produce( void *pvArg )
+{
+    producer_t *psProducer = pvArg;
+    msg_t *psMsg;
+    uint32_t i;
+    for( i = 0; i < _MESSAGES; i++ ) {
+        psMsg = list_node_alloc( sizeof( msg_t ) );
+        TEST_ASSERT(psMsg);
+        psMsg->m_uiProducer = psProducer->m_uiId;
+        psMsg->m_uiSeq = i;
+        mpscq_enqueue( psProducer->m_pvQueue, psMsg );
+    }
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          _consume
+ * @param [in]  psMsg   - Message taken from the queue
+ * @param [in]  puiNext - Next expected sequence number of each producer
+ * @return      None
+ * @brief       Check a message keeps the order of its producer and free it
+ *****************************************************************************/
+static void _consume( msg_t *psMsg, uint32_t *puiNext )
+{
+    TEST_ASSERT(psMsg->m_uiProducer < _PRODUCERS);
+    TEST_ASSERT(psMsg->m_uiSeq == puiNext[psMsg->m_uiProducer]);
+    puiNext[psMsg->m_uiProducer]++;
+    list_node_free( psMsg );
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_fifo
+ * @param       None
+ * @return      None
+ * @brief       A single thread gets its nodes back in order, one by one and
+ *              as a chain, and the nodes can be reused afterwards
+ *****************************************************************************/
+static void test_fifo( void )
+{
+    void *pvQueue = mpscq_create();
+    void *pvList = list_create();
+    void *apvNode[8];
+    void *pvNode;
+    void *pvNext;
+    uint32_t i;
+    TEST_ASSERT(pvQueue && pvList);
+    TEST_ASSERT(!mpscq_dequeue( pvQueue ) && !mpscq_dequeue_all( pvQueue ));
+    for( i = 0; i < 8; i++ ) {
+        apvNode[i] = list_node_alloc( sizeof( uint32_t ) );
+        mpscq_enqueue( pvQueue, apvNode[i] );
+    }
+    for( i = 0; i < 3; i++ ) {
+        TEST_ASSERT(mpscq_dequeue( pvQueue ) == apvNode[i]);
+        list_add_rear( pvList, apvNode[i] );
+    }
+    pvNode = mpscq_dequeue_all( pvQueue );
+    for( i = 3; pvNode; i++, pvNode = pvNext ) {
+        TEST_ASSERT(pvNode == apvNode[i]);
+        pvNext = mpscq_chain_next( pvNode );
+        list_add_rear( pvList, pvNode );
+    }
+    TEST_ASSERT(i == 8 && list_length( pvList ) == 8);
+    TEST_ASSERT(!mpscq_dequeue( pvQueue ));
+    list_flush( pvList );
+    /* Nodes still queued are freed with the queue */
+    for( i = 0; i < 4; i++ ) {
+        mpscq_enqueue( pvQueue, list_node_alloc( 16 ) );
+    }
+    mpscq_destroy( pvQueue );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_queued
+ * @param       None
+ * @return      None
+ * @brief       List calls leave queued nodes alone
+ *****************************************************************************/
+static void test_queued( void )
+{
+    void *pvQueue = mpscq_create();
+    void *pvList = list_create();
+    void *pvIdle = list_node_alloc( sizeof( uint32_t ) );
+    void *pvUsed = list_node_alloc( sizeof( uint32_t ) );
+    void *apvNode[3];
+    uint32_t i;
+    list_add_rear( pvList, pvUsed );
+    for( i = 0; i < 3; i++ ) {
+        apvNode[i] = list_node_alloc( sizeof( uint32_t ) );
+        mpscq_enqueue( pvQueue, apvNode[i] );
+    }
+    list_node_del( apvNode[1] );
+    list_node_del( apvNode[2] );
+    TEST_ASSERT(!list_node_next( apvNode[0] ) && !list_node_prev( apvNode[1] ));
+    list_node_swap( apvNode[1], pvIdle );
+    list_node_swap( pvUsed, apvNode[1] );
+    TEST_ASSERT(!list_node_resize( apvNode[1], 4096 ));
+    list_add_rear( pvList, apvNode[1] );
+    list_insert_before( apvNode[1], pvIdle );
+    list_node_free( apvNode[1] );
+    TEST_ASSERT(list_length( pvList ) == 1 && list_node_first( pvList ) == pvUsed);
+    mpscq_enqueue( pvQueue, apvNode[1] );
+    /* The queue is untouched */
+    for( i = 0; i < 3; i++ ) {
+        TEST_ASSERT(mpscq_dequeue( pvQueue ) == apvNode[i]);
+        list_add_rear( pvList, apvNode[i] );
+    }
+    TEST_ASSERT(!mpscq_dequeue( pvQueue ));
+    TEST_ASSERT(list_length( pvList ) == 4 && list_node_last( pvList ) == apvNode[2]);
+    list_node_free( pvIdle );
+    list_destroy( pvList );
+    mpscq_destroy( pvQueue );
+}
+
+/**************************************************************************//**
+ * @fn          test_stress
+ * @param       None
+ * @return      None
+ * @brief       Several producers race one consumer switching between single
+ *              and batch dequeues. Nothing is lost and each producer's order
+ *              is kept.
+ *****************************************************************************/
+static void test_stress( void )
+{
+    producer_t astProducer[_PRODUCERS];
+    uint32_t auiNext[_PRODUCERS] = { 0 };
+    void *pvQueue = mpscq_create();
+    msg_t *psMsg;
+    msg_t *psNext;
+    uint32_t uiTaken = 0;
+    uint32_t uiRound = 0;
+    uint32_t i;
+    TEST_ASSERT(pvQueue);
+    for( i = 0; i < _PRODUCERS; i++ ) {
+        astProducer[i].m_pvQueue = pvQueue;
+        astProducer[i].m_uiId = i;
+        TEST_ASSERT(!pthread_create( &astProducer[i].m_sThread, NULL, _produce, &astProducer[i] ));
+    }
+    while( uiTaken < _PRODUCERS * _MESSAGES ) {
+        if( (uiRound++ & 7) == 0 ) {
+            for( psMsg = mpscq_dequeue_all( pvQueue ); psMsg; psMsg = psNext ) {
+                psNext = mpscq_chain_next( psMsg );
+                _consume( psMsg, auiNext );
+                uiTaken++;
+            }
+        } else if( (psMsg = mpscq_dequeue( pvQueue )) ) {
+            _consume( psMsg, auiNext );
+            uiTaken++;
+        }
+    }
+    for( i = 0; i < _PRODUCERS; i++ ) {
+        pthread_join( astProducer[i].m_sThread, NULL );
+        TEST_ASSERT(auiNext[i] == _MESSAGES);
+    }
+    TEST_ASSERT(!mpscq_dequeue( pvQueue ));
+    mpscq_destroy( pvQueue );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_fifo);
+    if( TEST_MISUSE ) {
+        TEST_RUN(test_queued);
+    }
+    TEST_RUN(test_stress);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
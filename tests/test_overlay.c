@@ -0,0 +1,430 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_overlay.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the structures laid over a list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "list.h"
+#include <string.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _KEYS               (4096)
+#define _MODEL_MAX          (2048)
+#define _ROUNDS             (20000)
+
+/* Local Variables --------------------------------------------------------- */
+
+/* Nodes of the list under test in list order */
+static int *s_apiModel[_MODEL_MAX];
+static uint32_t s_uiModel;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _new_int
+ * @param [in]  iValue - Value of the node
+ * @return      Pointer to a new node holding an int
+ * @brief       Allocate a node holding an int
+ *****************************************************************************/
+static int *_new_int( int iValue )
+{
+    int *piNode = list_node_alloc( sizeof( int ) );
+    TEST_ASSERT(piNode);
+    *piNode = iValue;
+    return piNode;
+}
+
+/**************************************************************************//**
+ * @fn          _key
+ * @param [in]  pvNode - Pointer to an int node
+ * @return      Pointer to the key of the node
+ * @brief       The whole node is the key
+ *****************************************************************************/
+static const void *_key( const void *pvNode )
+{
+    return pvNode;
+}
+
+/**************************************************************************//**
+ * @fn          _hash
+ * @param [in]  pvKey - Pointer to an int key
+ * @return      Hash of the key
+ * @brief       A poor hash on purpose, so that keys collide in long runs and
+ *              deletes have to shift the runs back
+ *****************************************************************************/
+static uint32_t _hash( const void *pvKey )
+{
+    return (uint32_t)*(const int *)pvKey & 0x3Fu;
+}
+
+/**************************************************************************//**
+ * @fn          _eq
+ * @param [in]  pvKeyA - Pointer to an int key
+ * @param [in]  pvKeyB - Pointer to an int key
+ * @return      true if the keys are equal
+ * @brief       Compare two int keys
+ *****************************************************************************/
+static bool _eq( const void *pvKeyA, const void *pvKeyB )
+{
+    return *(const int *)pvKeyA == *(const int *)pvKeyB;
+}
+
+/**************************************************************************//**
+ * @fn          _cmp_int
+ * @param [in]  pvA - Pointer to an int
+ * @param [in]  pvB - Pointer to an int
+ * @return      Order of the two values
+ * @brief       Compare two ints, used for nodes and for keys
+ *****************************************************************************/
+static int _cmp_int( const void *pvA, const void *pvB )
+{
+    return (*(const int *)pvA > *(const int *)pvB) - (*(const int *)pvA < *(const int *)pvB);
+}
+
+/**************************************************************************//**
+ * @fn          _model_check
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Check the list against the model by walking it and by rank
+ *****************************************************************************/
+static void _model_check( void *pvList )
+{
+    void *pvNode;
+    uint32_t i = 0;
+    TEST_ASSERT(list_length( pvList ) == s_uiModel);
+    for( pvNode = list_node_first( pvList ); pvNode; pvNode = list_node_next( pvNode ) ) {
+        TEST_ASSERT(i < s_uiModel && pvNode == s_apiModel[i]);
+        i++;
+    }
+    TEST_ASSERT(i == s_uiModel);
+    for( i = 0; i < s_uiModel; i += 1 + (uint32_t)rand() % 7 ) {
+        TEST_ASSERT(list_node_at( pvList, i ) == s_apiModel[i]);
+        TEST_ASSERT(list_node_index( s_apiModel[i] ) == i);
+    }
+    TEST_ASSERT(!list_node_at( pvList, s_uiModel ));
+}
+
+/**************************************************************************//**
+ * @fn          _model_insert
+ * @param [in]  uiPos  - Place of the new node in the model
+ * @param [in]  piNode - New node
+ * @return      None
+ * @brief       Insert a node into the model
+ *****************************************************************************/
+static void _model_insert( uint32_t uiPos, int *piNode )
+{
+    memmove( &s_apiModel[uiPos + 1], &s_apiModel[uiPos], (s_uiModel - uiPos) * sizeof( int * ) );
+    s_apiModel[uiPos] = piNode;
+    s_uiModel++;
+}
+
+/**************************************************************************//**
+ * @fn          _model_remove
+ * @param [in]  uiPos - Place of the node in the model
+ * @return      The removed node
+ * @brief       Remove a node from the model
+ *****************************************************************************/
+static int *_model_remove( uint32_t uiPos )
+{
+    int *piNode = s_apiModel[uiPos];
+    s_uiModel--;
+    memmove( &s_apiModel[uiPos], &s_apiModel[uiPos + 1], (s_uiModel - uiPos) * sizeof( int * ) );
+    return piNode;
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_index
+ * @param       None
+ * @return      None
+ * @brief       The hash index finds every key through heavy churn on a table
+ *              full of collisions, and follows nodes moved between lists
+ *****************************************************************************/
+static void test_index( void )
+{
+    static int *s_apiKey[_KEYS];
+    void *pvList = list_create();
+    void *pvOther = list_create();
+    uint32_t uiRound;
+    uint32_t i;
+    int iKey;
+    TEST_ASSERT(list_index_create( pvList, _key, _hash, _eq ));
+    TEST_ASSERT(list_index_reserve( pvList, _KEYS ));
+    memset( s_apiKey, 0, sizeof( s_apiKey ) );
+    srand( 11 );
+    for( uiRound = 0; uiRound < 10 * _KEYS; uiRound++ ) {
+        iKey = rand() % _KEYS;
+        if( s_apiKey[iKey] ) {
+            TEST_ASSERT(list_find( pvList, &iKey ) == s_apiKey[iKey]);
+            list_node_del( s_apiKey[iKey] );
+            list_node_free( s_apiKey[iKey] );
+            s_apiKey[iKey] = NULL;
+            TEST_ASSERT(!list_find( pvList, &iKey ));
+        } else {
+            s_apiKey[iKey] = _new_int( iKey );
+            if( rand() & 1 ) {
+                list_add_rear( pvList, s_apiKey[iKey] );
+            } else {
+                list_add_front( pvList, s_apiKey[iKey] );
+            }
+        }
+        if( !(uiRound % 997) ) {
+            for( i = 0; i < _KEYS; i++ ) {
+                iKey = (int)i;
+                TEST_ASSERT(list_find( pvList, &iKey ) == s_apiKey[i]);
+            }
+        }
+    }
+    /* Nodes leaving through another list operation leave the index too */
+    for( iKey = 0; !s_apiKey[iKey]; iKey++ ) {
+    }
+    list_splice( pvOther, NULL, s_apiKey[iKey], s_apiKey[iKey] );
+    TEST_ASSERT(!list_find( pvList, &iKey ));
+    list_splice( pvList, NULL, s_apiKey[iKey], s_apiKey[iKey] );
+    TEST_ASSERT(list_find( pvList, &iKey ) == s_apiKey[iKey]);
+    s_apiKey[iKey] = list_node_resize( s_apiKey[iKey], 256 );
+    TEST_ASSERT(s_apiKey[iKey] && list_find( pvList, &iKey ) == s_apiKey[iKey]);
+    list_flush( pvList );
+    for( i = 0; i < _KEYS; i++ ) {
+        iKey = (int)i;
+        TEST_ASSERT(!list_find( pvList, &iKey ));
+    }
+    list_index_destroy( pvList );
+    TEST_ASSERT(!list_index_reserve( pvList, 16 ));
+    list_destroy( pvList );
+    list_destroy( pvOther );
+}
+
+/**************************************************************************//**
+ * @fn          test_reserve
+ * @param       None
+ * @return      None
+ * @brief       A pool backed list reserves nodes and index slots in one
+ *              chunk, and the index grows out of the chunk and back into a
+ *              new one
+ *****************************************************************************/
+static void test_reserve( void )
+{
+    void *pvPool = list_pool_create( sizeof( int ), 16 );
+    void *pvList = list_create_from( pvPool );
+    void *pvPlain = list_create();
+    int *piNode;
+    uint32_t i;
+    int iKey;
+    TEST_ASSERT(!list_reserve( pvPlain, 16 ) && !list_reserve( pvList, 0 ));
+    TEST_ASSERT(list_index_create( pvList, _key, _hash, _eq ));
+    TEST_ASSERT(list_reserve( pvList, 100 ));
+    TEST_ASSERT(list_reserve( pvList, 10 ));
+    for( i = 0; i < 300; i++ ) {
+        piNode = list_node_alloc_from( pvPool );
+        TEST_ASSERT(piNode);
+        *piNode = (int)i;
+        list_add_rear( pvList, piNode );
+    }
+    TEST_ASSERT(list_reserve( pvList, 1000 ));
+    for( i = 0; i < 300; i++ ) {
+        iKey = (int)i;
+        piNode = list_find( pvList, &iKey );
+        TEST_ASSERT(piNode && *piNode == iKey);
+    }
+    list_destroy( pvList );
+    list_destroy( pvPlain );
+    list_pool_destroy( pvPool );
+}
+
+/**************************************************************************//**
+ * @fn          test_skip
+ * @param       None
+ * @return      None
+ * @brief       Ranks stay right through random inserts and deletes, and after
+ *              a sort or a splice marks the skip list for a lazy rebuild
+ *****************************************************************************/
+static void test_skip( void )
+{
+    void *pvList = list_create();
+    void *pvOther = list_create();
+    int *piNode;
+    uint32_t uiRound;
+    uint32_t uiPos;
+    uint32_t i;
+    TEST_ASSERT(list_skip_create( pvList ));
+    s_uiModel = 0;
+    srand( 13 );
+    for( uiRound = 0; uiRound < _ROUNDS; uiRound++ ) {
+        uiPos = s_uiModel?((uint32_t)rand() % s_uiModel):0;
+        switch( (s_uiModel < _MODEL_MAX / 2)?(rand() % 3):(rand() % 4) ) {
+        case 0:
+            piNode = _new_int( rand() );
+            list_add_rear( pvList, piNode );
+            _model_insert( s_uiModel, piNode );
+            break;
+        case 1:
+            piNode = _new_int( rand() );
+            if( s_uiModel ) {
+                list_insert_before( s_apiModel[uiPos], piNode );
+            } else {
+                list_add_front( pvList, piNode );
+            }
+            _model_insert( uiPos, piNode );
+            break;
+        default:
+            if( s_uiModel ) {
+                piNode = _model_remove( uiPos );
+                list_node_del( piNode );
+                list_node_free( piNode );
+            }
+            break;
+        }
+        if( !(uiRound % 499) ) {
+            _model_check( pvList );
+        }
+    }
+    _model_check( pvList );
+    /* A sort reorders behind the skip list's back */
+    list_sort( pvList, _cmp_int );
+    qsort( s_apiModel, s_uiModel, sizeof( int * ), (int (*)( const void *, const void * ))_cmp_int );
+    for( piNode = list_node_first( pvList ), i = 0; piNode; piNode = list_node_next( piNode ), i++ ) {
+        s_apiModel[i] = piNode;
+    }
+    _model_check( pvList );
+    /* So does a splice out of and back into the list */
+    list_splice( pvOther, NULL, s_apiModel[10], s_apiModel[19] );
+    for( i = 0; i < 10; i++ ) {
+        _model_remove( 10 );
+    }
+    _model_check( pvList );
+    for( piNode = list_node_first( pvOther ), i = 0; piNode; piNode = list_node_next( piNode ), i++ ) {
+        _model_insert( i, piNode );
+    }
+    list_splice( pvList, s_apiModel[10], list_node_first( pvOther ), list_node_last( pvOther ) );
+    _model_check( pvList );
+    list_skip_destroy( pvList );
+    TEST_ASSERT(list_node_at( pvList, 5 ) == s_apiModel[5]);
+    list_destroy( pvList );
+    list_destroy( pvOther );
+}
+
+/**************************************************************************//**
+ * @fn          test_skip_only
+ * @param       None
+ * @return      None
+ * @brief       The index calls on a list with a skip list but no index fail
+ *              cleanly
+ *****************************************************************************/
+static void test_skip_only( void )
+{
+    void *pvList = list_create();
+    int iKey = 3;
+    int i;
+    TEST_ASSERT(list_skip_create( pvList ));
+    for( i = 0; i < 8; i++ ) {
+        list_add_rear( pvList, _new_int( i ) );
+    }
+    TEST_ASSERT(!list_find( pvList, &iKey ));
+    TEST_ASSERT(!list_index_reserve( pvList, 64 ));
+    TEST_ASSERT(*(int *)list_node_at( pvList, 3 ) == 3);
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_insert_sorted
+ * @param       None
+ * @return      None
+ * @brief       Sorted inserts keep the list in order and stable, and the
+ *              bounds agree with a linear scan
+ *****************************************************************************/
+static void test_insert_sorted( void )
+{
+    void *pvList = list_create();
+    int *piNode;
+    int *piPrev = NULL;
+    int *piLower;
+    int *piUpper;
+    uint32_t i;
+    int iKey;
+    srand( 17 );
+    for( i = 0; i < _MODEL_MAX; i++ ) {
+        piNode = list_node_alloc( 2 * sizeof( int ) );
+        piNode[0] = rand() % 300;
+        piNode[1] = (int)i;
+        list_insert_sorted( pvList, piNode, _cmp_int );
+    }
+    TEST_ASSERT(list_length( pvList ) == _MODEL_MAX);
+    /* The skip list attached on the way is not an index */
+    iKey = 0;
+    TEST_ASSERT(!list_find( pvList, &iKey ) && !list_index_reserve( pvList, 64 ));
+    i = 0;
+    for( piNode = list_node_first( pvList ); piNode; piNode = list_node_next( piNode ) ) {
+        TEST_ASSERT(!piPrev || piPrev[0] < piNode[0] || (piPrev[0] == piNode[0] && piPrev[1] < piNode[1]));
+        TEST_ASSERT(list_node_at( pvList, i ) == piNode);
+        piPrev = piNode;
+        i++;
+    }
+    for( iKey = -1; iKey <= 301; iKey++ ) {
+        piLower = NULL;
+        piUpper = NULL;
+        for( piNode = list_node_last( pvList ); piNode; piNode = list_node_prev( piNode ) ) {
+            if( piNode[0] >= iKey ) {
+                piLower = piNode;
+            }
+            if( piNode[0] > iKey ) {
+                piUpper = piNode;
+            }
+        }
+        TEST_ASSERT(list_lower_bound( pvList, &iKey, _cmp_int ) == piLower);
+        TEST_ASSERT(list_upper_bound( pvList, &iKey, _cmp_int ) == piUpper);
+    }
+    list_destroy( pvList );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_index);
+    TEST_RUN(test_reserve);
+    TEST_RUN(test_skip);
+    TEST_RUN(test_skip_only);
+    TEST_RUN(test_insert_sorted);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,256 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_rculist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior and stress checks of the read-mostly concurrent list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "rculist.h"
+#include <pthread.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _READERS            (4)
+#define _WRITERS            (2)
+#define _OPERATIONS         (20000)
+#define _WINDOW             (64)
+#define _MAGIC              (0x5AFEC0DEu)
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _ITEM_T {
+    uint32_t m_uiMagic;
+    uint32_t m_uiWriter;
+    uint32_t m_uiSeq;
+} item_t;
+
+typedef struct _WORKER_T {
+    pthread_t m_sThread;
+    void *m_pvList;
+    uint32_t m_uiId;
+    uint32_t m_uiWalks;
+} worker_t;
+
+/* Local Variables --------------------------------------------------------- */
+
+static volatile int s_iWriting;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _new_item
+ * @param [in]  uiWriter - Id of the writer
+ * @param [in]  uiSeq    - Sequence number within the writer
+ * @return      Pointer to a new item node
+ * @brief       Allocate an item node
+ *****************************************************************************/
+static item_t *_new_item( uint32_t uiWriter, uint32_t uiSeq )
+{
+    item_t *psItem = list_node_alloc( sizeof( item_t ) );
+    TEST_ASSERT(psItem);
+    psItem->m_uiMagic = _MAGIC;
+    psItem->m_uiWriter = uiWriter;
+    psItem->m_uiSeq = uiSeq;
+    return psItem;
+}
+
+/**************************************************************************//**
+ * @fn          _read
+ * @param [in]  pvArg - Pointer to the worker
+ * @return      NULL
+ * @brief       Walk the list while writers change it. Every node seen must be
+ *              a live item, and the items of each writer must come in the
+ *              order they were added.
+ *****************************************************************************/
+static void *_read( void *pvArg )
+{
+    worker_t *psWorker = pvArg;
+    uint32_t auiLast[_WRITERS];
+    void *pvReader = rculist_reader_register( psWorker->m_pvList );
+    item_t *psItem;
+    uint32_t i;
+    TEST_ASSERT(pvReader);
+    while( __atomic_load_n( &s_iWriting, __ATOMIC_ACQUIRE ) ) {
+        for( i = 0; i < _WRITERS; i++ ) {
+            auiLast[i] = 0;
+        }
+        rculist_read_lock( pvReader );
+        for( psItem = rculist_node_first( psWorker->m_pvList ); psItem;
+             psItem = rculist_node_next( psWorker->m_pvList, psItem ) ) {
+            TEST_ASSERT(psItem->m_uiMagic == _MAGIC && psItem->m_uiWriter < _WRITERS);
+            TEST_ASSERT(psItem->m_uiSeq >= auiLast[psItem->m_uiWriter]);
+            auiLast[psItem->m_uiWriter] = psItem->m_uiSeq + 1;
+        }
+        rculist_read_unlock( pvReader );
+        TEST_ASSERT(rculist_length( psWorker->m_pvList ) <= _WRITERS * _WINDOW);
+        psWorker->m_uiWalks++;
+    }
+    rculist_reader_unregister( psWorker->m_pvList, pvReader );
+    return NULL;
+}
+
+/**************************************************************************//**
+ * @fn          _write
+ * @param [in]  pvArg - Pointer to the worker
+ * @return      NULL
+ * @brief       Keep a sliding window of items in the list, adding new ones at
+ *              the end and deleting the oldest ones
+ *****************************************************************************/
+static void *_write( void *pvArg )
+{
+    worker_t *psWorker = pvArg;
+    item_t *apsLive[_WINDOW];
+    uint32_t uiSeq;
+    for( uiSeq = 0; uiSeq < _OPERATIONS; uiSeq++ ) {
+        if( uiSeq >= _WINDOW ) {
+            rculist_node_del( psWorker->m_pvList, apsLive[uiSeq % _WINDOW] );
+        }
+        apsLive[uiSeq % _WINDOW] = _new_item( psWorker->m_uiId, uiSeq );
+        rculist_add_rear( psWorker->m_pvList, apsLive[uiSeq % _WINDOW] );
+        if( !(uiSeq % 1000) ) {
+            rculist_synchronize( psWorker->m_pvList );
+        }
+    }
+    return NULL;
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_basic
+ * @param       None
+ * @return      None
+ * @brief       Adds, inserts and deletes from one thread keep the order and
+ *              the length right
+ *****************************************************************************/
+static void test_basic( void )
+{
+    void *pvList = rculist_create();
+    void *pvReader = rculist_reader_register( pvList );
+    void *pvOther = list_create();
+    item_t *apsItem[4];
+    item_t *psItem;
+    uint32_t auiOrder[] = { 1, 0, 3, 2 };
+    uint32_t i;
+    TEST_ASSERT(pvList && pvReader);
+    TEST_ASSERT(!rculist_node_first( pvList ) && rculist_length( pvList ) == 0);
+    for( i = 0; i < 4; i++ ) {
+        apsItem[i] = _new_item( 0, i );
+    }
+    rculist_add_rear( pvList, apsItem[0] );
+    rculist_add_front( pvList, apsItem[1] );
+    rculist_add_rear( pvList, apsItem[2] );
+    rculist_insert_after( pvList, apsItem[0], apsItem[3] );
+    TEST_ASSERT(rculist_length( pvList ) == 4);
+    rculist_read_lock( pvReader );
+    i = 0;
+    for( psItem = rculist_node_first( pvList ); psItem; psItem = rculist_node_next( pvList, psItem ) ) {
+        TEST_ASSERT(i < 4 && psItem == apsItem[auiOrder[i]]);
+        i++;
+    }
+    rculist_read_unlock( pvReader );
+    TEST_ASSERT(i == 4);
+    /* List calls leave members alone */
+    if( TEST_MISUSE ) {
+        list_node_del( apsItem[3] );
+        list_node_free( apsItem[3] );
+        list_add_rear( pvOther, apsItem[3] );
+        TEST_ASSERT(!list_node_resize( apsItem[3], 4096 ) && list_length( pvOther ) == 0);
+    }
+    TEST_ASSERT(rculist_node_next( pvList, apsItem[0] ) == apsItem[3] && rculist_length( pvList ) == 4);
+    rculist_node_del( pvList, apsItem[0] );
+    rculist_node_del( pvList, apsItem[2] );
+    TEST_ASSERT(rculist_length( pvList ) == 2);
+    rculist_synchronize( pvList );
+    TEST_ASSERT(rculist_node_first( pvList ) == apsItem[1]);
+    TEST_ASSERT(rculist_node_next( pvList, apsItem[1] ) == apsItem[3]);
+    TEST_ASSERT(!rculist_node_next( pvList, apsItem[3] ));
+    rculist_reader_unregister( pvList, pvReader );
+    rculist_destroy( pvList );
+    list_destroy( pvOther );
+}
+
+/**************************************************************************//**
+ * @fn          test_stress
+ * @param       None
+ * @return      None
+ * @brief       Readers walk the list without pause while several writers add
+ *              and delete nodes under them
+ *****************************************************************************/
+static void test_stress( void )
+{
+    worker_t astReader[_READERS];
+    worker_t astWriter[_WRITERS];
+    void *pvList = rculist_create();
+    uint32_t i;
+    TEST_ASSERT(pvList);
+    s_iWriting = 1;
+    for( i = 0; i < _READERS; i++ ) {
+        astReader[i].m_pvList = pvList;
+        astReader[i].m_uiId = i;
+        astReader[i].m_uiWalks = 0;
+        TEST_ASSERT(!pthread_create( &astReader[i].m_sThread, NULL, _read, &astReader[i] ));
+    }
+    for( i = 0; i < _WRITERS; i++ ) {
+        astWriter[i].m_pvList = pvList;
+        astWriter[i].m_uiId = i;
+        TEST_ASSERT(!pthread_create( &astWriter[i].m_sThread, NULL, _write, &astWriter[i] ));
+    }
+    for( i = 0; i < _WRITERS; i++ ) {
+        pthread_join( astWriter[i].m_sThread, NULL );
+    }
+    __atomic_store_n( &s_iWriting, 0, __ATOMIC_RELEASE );
+    for( i = 0; i < _READERS; i++ ) {
+        pthread_join( astReader[i].m_sThread, NULL );
+        TEST_ASSERT(astReader[i].m_uiWalks > 0);
+    }
+    TEST_ASSERT(rculist_length( pvList ) == _WRITERS * _WINDOW);
+    rculist_synchronize( pvList );
+    rculist_destroy( pvList );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_basic);
+    TEST_RUN(test_stress);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,246 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_stats.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the list counters, in a library built with
+ *              or without LIST_CFG_STATS
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "list.h"
+#include <string.h>
+#include <unistd.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _DUMP_SIZE          (64 * 1024)
+
+/* Local Variables --------------------------------------------------------- */
+
+static char s_acDump[_DUMP_SIZE];
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _count
+ * @param [in]  pvNode - Pointer to a node
+ * @param [in]  pvCtx  - Pointer to a counter
+ * @return      0 to go on
+ * @brief       Count the nodes or lists visited
+ *****************************************************************************/
+static int _count( void *pvNode, void *pvCtx )
+{
+    (void)pvNode;
+    (*(uint32_t *)pvCtx)++;
+    return 0;
+}
+
+/**************************************************************************//**
+ * @fn          _find
+ * @param [in]  pvList - List handle from the registry
+ * @param [in]  pvCtx  - Pointer to the list handle looked for
+ * @return      1 to stop at the list looked for
+ * @brief       Tell whether a list is in the registry
+ *****************************************************************************/
+static int _find( void *pvList, void *pvCtx )
+{
+    if( pvList == *(void **)pvCtx ) {
+        *(void **)pvCtx = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+/**************************************************************************//**
+ * @fn          _dump
+ * @param       None
+ * @return      Text written by list_stats_dump
+ * @brief       Run list_stats_dump into a temporary file and read it back
+ *****************************************************************************/
+static const char *_dump( void )
+{
+    char acPath[] = "/tmp/easylist_stats_XXXXXX";
+    ssize_t lLen;
+    int iFd = mkstemp( acPath );
+    TEST_ASSERT(iFd >= 0);
+    unlink( acPath );
+    TEST_ASSERT(list_stats_dump( iFd ));
+    lLen = pread( iFd, s_acDump, sizeof( s_acDump ) - 1, 0 );
+    close( iFd );
+    TEST_ASSERT(lLen > 0);
+    s_acDump[lLen] = '\0';
+    return s_acDump;
+}
+
+/**************************************************************************//**
+ * @fn          _json_balanced
+ * @param [in]  pcText - Text to check
+ * @return      true if every bracket outside of strings is closed in order
+ * @brief       Cheap well-formedness check of a JSON text
+ *****************************************************************************/
+static bool _json_balanced( const char *pcText )
+{
+    char acStack[16];
+    uint32_t uiDepth = 0;
+    bool bString = false;
+    for( ; *pcText; pcText++ ) {
+        if( bString ) {
+            bString = (*pcText != '"');
+        } else if( *pcText == '"' ) {
+            bString = true;
+        } else if( *pcText == '{' || *pcText == '[' ) {
+            if( uiDepth == sizeof( acStack ) ) {
+                return false;
+            }
+            acStack[uiDepth++] = (*pcText == '{')?'}':']';
+        } else if( *pcText == '}' || *pcText == ']' ) {
+            if( !uiDepth || acStack[--uiDepth] != *pcText ) {
+                return false;
+            }
+        }
+    }
+    return !uiDepth && !bString;
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_counters
+ * @param       None
+ * @return      None
+ * @brief       Joins, leaves, walks and sizes are counted per list, lists
+ *              created with LIST_OPT_NO_OWNER are not counted
+ *****************************************************************************/
+static void test_counters( void )
+{
+    void *pvList = list_create();
+    void *pvAnon = list_create_ex( NULL, LIST_OPT_NO_OWNER );
+    void *pvNode = list_node_alloc( 100 );
+    list_stats_t sStats;
+    uint32_t uiSteps = 0;
+    TEST_ASSERT(pvList && pvAnon && pvNode);
+    list_add_rear( pvList, list_node_alloc( 4 ) );
+    list_add_rear( pvList, pvNode );
+    list_add_rear( pvList, list_node_alloc( 5000 ) );
+    list_add_rear( pvAnon, list_node_alloc( 4 ) );
+    list_node_del( pvNode );
+    list_for_each( pvList, _count, &uiSteps );
+    list_for_each_reverse( pvList, _count, &uiSteps );
+    list_node_next( list_node_first( pvList ) );
+    TEST_ASSERT(uiSteps == 4);
+    TEST_ASSERT(!list_stats_get( pvAnon, &sStats ));
+#ifdef LIST_CFG_STATS
+    TEST_ASSERT(list_stats_get( pvList, &sStats ));
+    TEST_ASSERT(sStats.m_ulInserts == 3 && sStats.m_ulDeletes == 1 && sStats.m_ulPeak == 3);
+    TEST_ASSERT(sStats.m_ulNext == 2 && sStats.m_ulPrev == 2);
+    TEST_ASSERT(sStats.m_ulBytesIn == 3 * sizeof( node_head_t ) + 5104);
+    TEST_ASSERT(sStats.m_ulBytesOut == sizeof( node_head_t ) + 100);
+    TEST_ASSERT(sStats.m_aulSizeHist[0] == 1 && sStats.m_aulSizeHist[4] == 1 && sStats.m_aulSizeHist[10] == 1);
+    list_flush( pvList );
+    TEST_ASSERT(list_stats_get( pvList, &sStats ));
+    TEST_ASSERT(sStats.m_ulDeletes == 3 && sStats.m_ulBytesOut == sStats.m_ulBytesIn);
+#else
+    TEST_ASSERT(!list_stats_get( pvList, &sStats ));
+#endif
+    list_node_free( pvNode );
+    list_destroy( pvAnon );
+    list_destroy( pvList );
+}
+
+/**************************************************************************//**
+ * @fn          test_registry
+ * @param       None
+ * @return      None
+ * @brief       Counted lists are in the registry while they live
+ *****************************************************************************/
+static void test_registry( void )
+{
+    void *pvList = list_create();
+    void *pvLook = pvList;
+    uint32_t uiBefore = 0;
+    uint32_t uiAfter = 0;
+    list_stats_for_each( _count, &uiBefore );
+    list_stats_for_each( _find, &pvLook );
+    list_destroy( pvList );
+    list_stats_for_each( _count, &uiAfter );
+#ifdef LIST_CFG_STATS
+    TEST_ASSERT(!pvLook && uiBefore == uiAfter + 1);
+#else
+    TEST_ASSERT(pvLook == pvList && !uiBefore && !uiAfter);
+#endif
+}
+
+/**************************************************************************//**
+ * @fn          test_dump
+ * @param       None
+ * @return      None
+ * @brief       The report is well formed JSON holding the named counters
+ *****************************************************************************/
+static void test_dump( void )
+{
+    void *pvList = list_create();
+    const char *pcDump;
+    void *pvNode = list_node_alloc( 4 );
+    list_add_rear( pvList, pvNode );
+    list_add_rear( pvList, list_node_alloc( 100 ) );
+    list_node_del( pvNode );
+    list_node_free( pvNode );
+    list_stats_name( pvList, "jobs \"q\"\n" );
+    pcDump = _dump();
+    TEST_ASSERT(_json_balanced( pcDump ));
+#ifdef LIST_CFG_STATS
+    TEST_ASSERT(!strncmp( pcDump, "{\"enabled\":true,", 16 ));
+    TEST_ASSERT(strstr( pcDump, "\"name\":\"jobs _q__\",\"length\":1,\"peak\":2,"
+                                "\"inserts\":2,\"deletes\":1," ));
+    TEST_ASSERT(strstr( pcDump, "\"size_hist\":{\"8\":1,\"128\":1}}" ));
+#else
+    TEST_ASSERT(!strcmp( pcDump, "{\"enabled\":false,\"lists\":[]}\n" ));
+#endif
+    list_destroy( pvList );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_counters);
+    TEST_RUN(test_registry);
+    TEST_RUN(test_dump);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,212 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        test_ulist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Behavior checks of the unrolled list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+#include "test.h"
+#include "ulist.h"
+#include <string.h>
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _MODEL_MAX          (600)
+#define _ROUNDS             (20000)
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _WALK_T {
+    const int *m_piModel;
+    uint32_t m_uiSeen;
+    uint32_t m_uiStop;
+} walk_t;
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _visit
+ * @param [in]  pvElem - Pointer to an element
+ * @param [in]  pvCtx  - Pointer to the walk state
+ * @return      Non-zero to stop the walk
+ * @brief       Visitor checking elements come in model order
+ *****************************************************************************/
+static int _visit( void *pvElem, void *pvCtx )
+{
+    walk_t *psWalk = pvCtx;
+    TEST_ASSERT(*(int *)pvElem == psWalk->m_piModel[psWalk->m_uiSeen]);
+    psWalk->m_uiSeen++;
+    return psWalk->m_uiSeen == psWalk->m_uiStop;
+}
+
+/**************************************************************************//**
+ * @fn          _seek
+ * @param [in]  pvList - List handle
+ * @param [in]  uiPos  - Index of the element
+ * @param [out] psPos  - Position of the element
+ * @return      None
+ * @brief       Get the position of the element at an index
+ *****************************************************************************/
+static void _seek( void *pvList, uint32_t uiPos, ulist_pos_t *psPos )
+{
+    TEST_ASSERT(ulist_first( pvList, psPos ));
+    while( uiPos-- ) {
+        TEST_ASSERT(ulist_next( pvList, psPos ));
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _check
+ * @param [in]  pvList   - List handle
+ * @param [in]  piModel  - Elements the list must hold in order
+ * @param [in]  uiCount  - Number of elements
+ * @return      None
+ * @brief       Check a list against a model forwards, backwards and by a
+ *              full and a stopped walk
+ *****************************************************************************/
+static void _check( void *pvList, const int *piModel, uint32_t uiCount )
+{
+    ulist_pos_t stPos;
+    walk_t stWalk;
+    uint32_t i = 0;
+    bool bMore;
+    TEST_ASSERT(ulist_length( pvList ) == uiCount);
+    for( bMore = ulist_first( pvList, &stPos ); bMore; bMore = ulist_next( pvList, &stPos ) ) {
+        TEST_ASSERT(i < uiCount && *(int *)ulist_data( pvList, &stPos ) == piModel[i]);
+        i++;
+    }
+    TEST_ASSERT(i == uiCount);
+    for( bMore = ulist_last( pvList, &stPos ); bMore; bMore = ulist_prev( pvList, &stPos ) ) {
+        TEST_ASSERT(i > 0 && *(int *)ulist_data( pvList, &stPos ) == piModel[i - 1]);
+        i--;
+    }
+    TEST_ASSERT(i == 0);
+    stWalk.m_piModel = piModel;
+    stWalk.m_uiSeen = 0;
+    stWalk.m_uiStop = 0;
+    ulist_for_each( pvList, _visit, &stWalk );
+    TEST_ASSERT(stWalk.m_uiSeen == uiCount);
+    if( uiCount ) {
+        stWalk.m_uiSeen = 0;
+        stWalk.m_uiStop = (uiCount + 1) / 2;
+        ulist_for_each( pvList, _visit, &stWalk );
+        TEST_ASSERT(stWalk.m_uiSeen == stWalk.m_uiStop);
+    }
+}
+
+/* Tests ------------------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          test_model
+ * @param       None
+ * @return      None
+ * @brief       Random adds, inserts and erases agree with an array model
+ *              while small blocks keep splitting and merging
+ *****************************************************************************/
+static void test_model( void )
+{
+    static int s_aiModel[_MODEL_MAX];
+    void *pvList = ulist_create( sizeof( int ), 4 );
+    ulist_pos_t stPos;
+    uint32_t uiCount = 0;
+    uint32_t uiRound;
+    uint32_t uiPos;
+    int *piElem;
+    int iValue;
+    TEST_ASSERT(pvList);
+    TEST_ASSERT(!ulist_first( pvList, &stPos ) && !ulist_last( pvList, &stPos ));
+    srand( 23 );
+    for( uiRound = 0; uiRound < _ROUNDS; uiRound++ ) {
+        uiPos = uiCount?((uint32_t)rand() % uiCount):0;
+        iValue = (int)uiRound;
+        if( uiCount == 0 || (uiCount < _MODEL_MAX && rand() % 2) ) {
+            switch( rand() % (uiCount?4:2) ) {
+            case 0:
+                piElem = ulist_add_rear( pvList, &iValue );
+                uiPos = uiCount;
+                break;
+            case 1:
+                piElem = ulist_add_front( pvList, &iValue );
+                uiPos = 0;
+                break;
+            case 2:
+                _seek( pvList, uiPos, &stPos );
+                piElem = ulist_insert_before( pvList, &stPos, &iValue );
+                TEST_ASSERT(ulist_data( pvList, &stPos ) == piElem);
+                break;
+            default:
+                _seek( pvList, uiPos, &stPos );
+                piElem = ulist_insert_after( pvList, &stPos, &iValue );
+                TEST_ASSERT(ulist_data( pvList, &stPos ) == piElem);
+                uiPos++;
+                break;
+            }
+            TEST_ASSERT(piElem && *piElem == iValue);
+            memmove( &s_aiModel[uiPos + 1], &s_aiModel[uiPos], (uiCount - uiPos) * sizeof( int ) );
+            s_aiModel[uiPos] = iValue;
+            uiCount++;
+        } else {
+            _seek( pvList, uiPos, &stPos );
+            ulist_erase( pvList, &stPos );
+            uiCount--;
+            memmove( &s_aiModel[uiPos], &s_aiModel[uiPos + 1], (uiCount - uiPos) * sizeof( int ) );
+            /* The position moves on to the element that followed */
+            if( uiPos < uiCount ) {
+                TEST_ASSERT(*(int *)ulist_data( pvList, &stPos ) == s_aiModel[uiPos]);
+            }
+        }
+        if( !(uiRound % 97) ) {
+            _check( pvList, s_aiModel, uiCount );
+        }
+    }
+    _check( pvList, s_aiModel, uiCount );
+    ulist_flush( pvList );
+    _check( pvList, NULL, 0 );
+    ulist_add_rear( pvList, NULL );
+    TEST_ASSERT(ulist_length( pvList ) == 1);
+    ulist_destroy( pvList );
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+int main( void )
+{
+    TEST_RUN(test_model);
+    return 0;
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
@@ -0,0 +1,566 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        ulist.c
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Unrolled doubly linked list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+/* Includes ---------------------------------------------------------------- */
+
+#include "ulist.h"
+#include "string.h"
+#include "stdlib.h"
+
+/* Macro Definitions ------------------------------------------------------- */
+
+#define _BLOCK_BYTES        (256u)  /* Default payload bytes of a block */
+#define _MIN_BLOCK_ELEMS    (4u)
+
+#define _ELEM(l,b,i)        ((void *)(b)->m_pData+(size_t)(i)*(l)->m_uiElemSize)
+#define _IS_POS(p)          (((p))&&((p)->m_pvBlock)&&\
+                             ((p)->m_uiIndex<((ulist_block_t *)(p)->m_pvBlock)->m_uiCount))
+
+/* Type Definitions -------------------------------------------------------- */
+
+typedef struct _ULIST_BLOCK_T ulist_block_t;
+typedef struct _ULIST_T ulist_t;
+
+struct _ULIST_BLOCK_T {
+    ulist_block_t *m_psNext;
+    ulist_block_t *m_psPrev;
+    uint32_t m_uiCount;
+    uint32_t m_uiReserved;
+    uint8_t m_pData[];
+};
+
+struct _ULIST_T {
+    ulist_block_t *m_psFirst;
+    ulist_block_t *m_psLast;
+    uint32_t m_uiElemSize;
+    uint32_t m_uiBlockElems;
+    uint32_t m_uiSize;
+};
+
+/* Local Functions --------------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          _block_new
+ * @param [in]  psList - Pointer to a list
+ * @param [in]  psPrev - Block to link after, NULL to link at the beginning
+ * @return      Pointer to the created block or NULL if failed
+ * @brief       Create an empty block and link it after another one
+ *****************************************************************************/
+static ulist_block_t *_block_new( ulist_t *psList, ulist_block_t *psPrev )
+{
+    ulist_block_t *psBlock = malloc( sizeof( ulist_block_t )
+                                     + (size_t)psList->m_uiBlockElems * psList->m_uiElemSize );
+    if( psBlock ) {
+        psBlock->m_uiCount = 0;
+        psBlock->m_psPrev = psPrev;
+        psBlock->m_psNext = psPrev?psPrev->m_psNext:psList->m_psFirst;
+        if( psBlock->m_psNext ) {
+            psBlock->m_psNext->m_psPrev = psBlock;
+        } else {
+            psList->m_psLast = psBlock;
+        }
+        if( psPrev ) {
+            psPrev->m_psNext = psBlock;
+        } else {
+            psList->m_psFirst = psBlock;
+        }
+    }
+    return psBlock;
+}
+
+/**************************************************************************//**
+ * @fn          _block_free
+ * @param [in]  psList  - Pointer to a list
+ * @param [in]  psBlock - Pointer to a block
+ * @return      None
+ * @brief       Unlink a block and free it
+ *****************************************************************************/
+static void _block_free( ulist_t *psList, ulist_block_t *psBlock )
+{
+    if( psBlock->m_psPrev ) {
+        psBlock->m_psPrev->m_psNext = psBlock->m_psNext;
+    } else {
+        psList->m_psFirst = psBlock->m_psNext;
+    }
+    if( psBlock->m_psNext ) {
+        psBlock->m_psNext->m_psPrev = psBlock->m_psPrev;
+    } else {
+        psList->m_psLast = psBlock->m_psPrev;
+    }
+    free( psBlock );
+}
+
+/**************************************************************************//**
+ * @fn          _block_insert
+ * @param [in]  psList  - Pointer to a list
+ * @param [in]  psBlock - Pointer to a block with room for one more element
+ * @param [in]  uiIndex - Index to insert at, up to the count of the block
+ * @param [in]  pvData  - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the inserted element
+ * @brief       Insert an element into the array of a block
+ *****************************************************************************/
+static void *_block_insert( ulist_t *psList, ulist_block_t *psBlock,
+                            uint32_t uiIndex, const void *pvData )
+{
+    void *pvElem = _ELEM(psList, psBlock, uiIndex);
+    memmove( pvElem + psList->m_uiElemSize, pvElem,
+             (size_t)(psBlock->m_uiCount - uiIndex) * psList->m_uiElemSize );
+    if( pvData ) {
+        memcpy( pvElem, pvData, psList->m_uiElemSize );
+    }
+    psBlock->m_uiCount++;
+    psList->m_uiSize++;
+    return pvElem;
+}
+
+/**************************************************************************//**
+ * @fn          _normalize
+ * @param [in,out] psPos - Position to fix up
+ * @return      None
+ * @brief       Move a position past the end of a block to the next block
+ *****************************************************************************/
+static void _normalize( ulist_pos_t *psPos )
+{
+    ulist_block_t *psBlock = psPos->m_pvBlock;
+    if( psBlock && psPos->m_uiIndex >= psBlock->m_uiCount ) {
+        psPos->m_pvBlock = psBlock->m_psNext;
+        psPos->m_uiIndex = 0;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          _make_room
+ * @param [in]  psList - Pointer to a list
+ * @param [in,out] psPos - Insertion point, may be one past the last element
+ *                         of its block
+ * @return      true if the block of the insertion point has room
+ * @brief       Split a full block in two halves, keeping the insertion point
+ *              on the same element boundary
+ *****************************************************************************/
+static bool _make_room( ulist_t *psList, ulist_pos_t *psPos )
+{
+    ulist_block_t *psBlock = psPos->m_pvBlock;
+    ulist_block_t *psSplit;
+    uint32_t uiHalf;
+    if( psBlock->m_uiCount < psList->m_uiBlockElems ) {
+        return true;
+    }
+    psSplit = _block_new( psList, psBlock );
+    if( !psSplit ) {
+        return false;
+    }
+    uiHalf = psBlock->m_uiCount / 2;
+    psSplit->m_uiCount = psBlock->m_uiCount - uiHalf;
+    memcpy( psSplit->m_pData, _ELEM(psList, psBlock, uiHalf),
+            (size_t)psSplit->m_uiCount * psList->m_uiElemSize );
+    psBlock->m_uiCount = uiHalf;
+    if( psPos->m_uiIndex > uiHalf ) {
+        psPos->m_pvBlock = psSplit;
+        psPos->m_uiIndex -= uiHalf;
+    }
+    return true;
+}
+
+/* Function Definitions ---------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          ulist_create
+ * @param [in]  uiElemSize   - Size of every element
+ * @param [in]  uiBlockElems - Number of elements per block, 0 for default
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty unrolled list. Elements are stored by value
+ *              in blocks holding a small array each, so a walk touches
+ *              memory mostly contiguously.
+ *****************************************************************************/
+void *ulist_create( uint32_t uiElemSize, uint32_t uiBlockElems )
+{
+    ulist_t *psList;
+    if( !uiElemSize ) {
+        return NULL;
+    }
+    if( !uiBlockElems ) {
+        uiBlockElems = _BLOCK_BYTES / uiElemSize;
+    }
+    if( uiBlockElems < _MIN_BLOCK_ELEMS ) {
+        uiBlockElems = _MIN_BLOCK_ELEMS;
+    }
+    psList = malloc( sizeof( ulist_t ) );
+    if( psList ) {
+        psList->m_psFirst = NULL;
+        psList->m_psLast = NULL;
+        psList->m_uiElemSize = uiElemSize;
+        psList->m_uiBlockElems = uiBlockElems;
+        psList->m_uiSize = 0;
+    }
+    return psList;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the added element or NULL if failed
+ * @brief       Add an element at the end of a list
+ *****************************************************************************/
+void *ulist_add_rear( void *pvList, const void *pvData )
+{
+    ulist_t *psList = pvList;
+    ulist_block_t *psBlock;
+    if( !psList ) {
+        return NULL;
+    }
+    psBlock = psList->m_psLast;
+    if( !psBlock || psBlock->m_uiCount == psList->m_uiBlockElems ) {
+        psBlock = _block_new( psList, psList->m_psLast );
+        if( !psBlock ) {
+            return NULL;
+        }
+    }
+    return _block_insert( psList, psBlock, psBlock->m_uiCount, pvData );
+}
+
+/**************************************************************************//**
+ * @fn          ulist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the added element or NULL if failed
+ * @brief       Add an element at the beginning of a list
+ *****************************************************************************/
+void *ulist_add_front( void *pvList, const void *pvData )
+{
+    ulist_t *psList = pvList;
+    ulist_block_t *psBlock;
+    if( !psList ) {
+        return NULL;
+    }
+    psBlock = psList->m_psFirst;
+    if( !psBlock || psBlock->m_uiCount == psList->m_uiBlockElems ) {
+        psBlock = _block_new( psList, NULL );
+        if( !psBlock ) {
+            return NULL;
+        }
+    }
+    return _block_insert( psList, psBlock, 0, pvData );
+}
+
+/**************************************************************************//**
+ * @fn          ulist_insert_before
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the inserted one
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the inserted element or NULL if failed
+ * @brief       Insert an element before another element. A full block is
+ *              split in two halves first.
+ *****************************************************************************/
+void *ulist_insert_before( void *pvList, ulist_pos_t *psPos, const void *pvData )
+{
+    ulist_t *psList = pvList;
+    ulist_pos_t sPos;
+    if( !psList || !_IS_POS(psPos) ) {
+        return NULL;
+    }
+    sPos = *psPos;
+    if( !_make_room( psList, &sPos ) ) {
+        return NULL;
+    }
+    *psPos = sPos;
+    return _block_insert( psList, psPos->m_pvBlock, psPos->m_uiIndex, pvData );
+}
+
+/**************************************************************************//**
+ * @fn          ulist_insert_after
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the inserted one
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the inserted element or NULL if failed
+ * @brief       Insert an element after another element. A full block is
+ *              split in two halves first.
+ *****************************************************************************/
+void *ulist_insert_after( void *pvList, ulist_pos_t *psPos, const void *pvData )
+{
+    ulist_t *psList = pvList;
+    ulist_pos_t sPos;
+    if( !psList || !_IS_POS(psPos) ) {
+        return NULL;
+    }
+    sPos.m_pvBlock = psPos->m_pvBlock;
+    sPos.m_uiIndex = psPos->m_uiIndex + 1;
+    if( !_make_room( psList, &sPos ) ) {
+        return NULL;
+    }
+    *psPos = sPos;
+    return _block_insert( psList, psPos->m_pvBlock, psPos->m_uiIndex, pvData );
+}
+
+/**************************************************************************//**
+ * @fn          ulist_erase
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the one following it
+ * @return      None
+ * @brief       Delete an element from list. A block less than half full is
+ *              merged with a neighbour when they fit in one block.
+ *****************************************************************************/
+void ulist_erase( void *pvList, ulist_pos_t *psPos )
+{
+    ulist_t *psList = pvList;
+    ulist_block_t *psBlock;
+    ulist_block_t *psPeer;
+    void *pvElem;
+    if( !psList || !_IS_POS(psPos) ) {
+        return;
+    }
+    psBlock = psPos->m_pvBlock;
+    pvElem = _ELEM(psList, psBlock, psPos->m_uiIndex);
+    psBlock->m_uiCount--;
+    psList->m_uiSize--;
+    memmove( pvElem, pvElem + psList->m_uiElemSize,
+             (size_t)(psBlock->m_uiCount - psPos->m_uiIndex) * psList->m_uiElemSize );
+    if( !psBlock->m_uiCount ) {
+        psPos->m_pvBlock = psBlock->m_psNext;
+        psPos->m_uiIndex = 0;
+        _block_free( psList, psBlock );
+        return;
+    }
+    if( psBlock->m_uiCount < psList->m_uiBlockElems / 2 ) {
+        psPeer = psBlock->m_psNext;
+        if( psPeer && psBlock->m_uiCount + psPeer->m_uiCount <= psList->m_uiBlockElems ) {
+            /* Pull the next block in, the position keeps its index */
+            memcpy( _ELEM(psList, psBlock, psBlock->m_uiCount), psPeer->m_pData,
+                    (size_t)psPeer->m_uiCount * psList->m_uiElemSize );
+            psBlock->m_uiCount += psPeer->m_uiCount;
+            _block_free( psList, psPeer );
+        } else {
+            psPeer = psBlock->m_psPrev;
+            if( psPeer && psBlock->m_uiCount + psPeer->m_uiCount <= psList->m_uiBlockElems ) {
+                /* Push into the previous block, the position follows */
+                memcpy( _ELEM(psList, psPeer, psPeer->m_uiCount), psBlock->m_pData,
+                        (size_t)psBlock->m_uiCount * psList->m_uiElemSize );
+                psPos->m_pvBlock = psPeer;
+                psPos->m_uiIndex += psPeer->m_uiCount;
+                psPeer->m_uiCount += psBlock->m_uiCount;
+                _block_free( psList, psBlock );
+            }
+        }
+    }
+    _normalize( psPos );
+}
+
+/**************************************************************************//**
+ * @fn          ulist_first
+ * @param [in]  pvList - List handle
+ * @param [out] psPos  - Position of the element
+ * @return      true if founded, false if the list is empty
+ * @brief       Get the element at the beginning of the specified list.
+ *****************************************************************************/
+bool ulist_first( void *pvList, ulist_pos_t *psPos )
+{
+    ulist_t *psList = pvList;
+    if( !psList || !psPos || !psList->m_psFirst ) {
+        return false;
+    }
+    psPos->m_pvBlock = psList->m_psFirst;
+    psPos->m_uiIndex = 0;
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_last
+ * @param [in]  pvList - List handle
+ * @param [out] psPos  - Position of the element
+ * @return      true if founded, false if the list is empty
+ * @brief       Get the element at the end of the specified list.
+ *****************************************************************************/
+bool ulist_last( void *pvList, ulist_pos_t *psPos )
+{
+    ulist_t *psList = pvList;
+    if( !psList || !psPos || !psList->m_psLast ) {
+        return false;
+    }
+    psPos->m_pvBlock = psList->m_psLast;
+    psPos->m_uiIndex = psList->m_psLast->m_uiCount - 1;
+    return true;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_next
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the next one
+ * @return      true if moved, false if reach the end of list
+ * @brief       Move a position to the next element
+ *****************************************************************************/
+bool ulist_next( void *pvList, ulist_pos_t *psPos )
+{
+    ulist_block_t *psBlock;
+    if( !pvList || !_IS_POS(psPos) ) {
+        return false;
+    }
+    psBlock = psPos->m_pvBlock;
+    if( psPos->m_uiIndex + 1 < psBlock->m_uiCount ) {
+        psPos->m_uiIndex++;
+        return true;
+    }
+    if( psBlock->m_psNext ) {
+        psPos->m_pvBlock = psBlock->m_psNext;
+        psPos->m_uiIndex = 0;
+        return true;
+    }
+    return false;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_prev
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the previous one
+ * @return      true if moved, false if reach the beginning of list
+ * @brief       Move a position to the previous element
+ *****************************************************************************/
+bool ulist_prev( void *pvList, ulist_pos_t *psPos )
+{
+    ulist_block_t *psBlock;
+    if( !pvList || !_IS_POS(psPos) ) {
+        return false;
+    }
+    psBlock = psPos->m_pvBlock;
+    if( psPos->m_uiIndex > 0 ) {
+        psPos->m_uiIndex--;
+        return true;
+    }
+    if( psBlock->m_psPrev ) {
+        psPos->m_pvBlock = psBlock->m_psPrev;
+        psPos->m_uiIndex = psBlock->m_psPrev->m_uiCount - 1;
+        return true;
+    }
+    return false;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_data
+ * @param [in]  pvList - List handle
+ * @param [in]  psPos  - Position of an element
+ * @return      Pointer to the element or NULL if not a valid position
+ * @brief       Get the element at a position
+ *****************************************************************************/
+void *ulist_data( void *pvList, const ulist_pos_t *psPos )
+{
+    ulist_t *psList = pvList;
+    if( !psList || !_IS_POS(psPos) ) {
+        return NULL;
+    }
+    return _ELEM(psList, (ulist_block_t *)psPos->m_pvBlock, psPos->m_uiIndex);
+}
+
+/**************************************************************************//**
+ * @fn          ulist_for_each
+ * @param [in]  pvList - List handle
+ * @param [in]  pfnVisit - Visitor called on every element in order
+ * @param [in]  pvCtx  - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all elements, scanning the array of each block
+ *****************************************************************************/
+void ulist_for_each( void *pvList, ulist_visit_t pfnVisit, void *pvCtx )
+{
+    ulist_t *psList = pvList;
+    ulist_block_t *psBlock;
+    void *pvElem;
+    void *pvEnd;
+    if( !psList || !pfnVisit ) {
+        return;
+    }
+    for( psBlock = psList->m_psFirst; psBlock; psBlock = psBlock->m_psNext ) {
+        if( psBlock->m_psNext ) {
+            __builtin_prefetch( psBlock->m_psNext );
+        }
+        pvEnd = _ELEM(psList, psBlock, psBlock->m_uiCount);
+        for( pvElem = psBlock->m_pData; pvElem < pvEnd; pvElem += psList->m_uiElemSize ) {
+            if( pfnVisit( pvElem, pvCtx ) ) {
+                return;
+            }
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @fn          ulist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of elements in the list.
+ * @brief       Get the number of elements in a list.
+ *****************************************************************************/
+uint32_t ulist_length( void *pvList )
+{
+    ulist_t *psList = pvList;
+    return psList?psList->m_uiSize:0;
+}
+
+/**************************************************************************//**
+ * @fn          ulist_flush
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Flush a list. All elements and blocks will be freed
+ *****************************************************************************/
+void ulist_flush( void *pvList )
+{
+    ulist_t *psList = pvList;
+    ulist_block_t *psBlock;
+    if( psList ) {
+        while( psList->m_psFirst ) {
+            psBlock = psList->m_psFirst;
+            psList->m_psFirst = psBlock->m_psNext;
+            free( psBlock );
+        }
+        psList->m_psLast = NULL;
+        psList->m_uiSize = 0;
+    }
+}
+
+/**************************************************************************//**
+ * @fn          ulist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including all elements in it.
+ *****************************************************************************/
+void ulist_destroy( void *pvList )
+{
+    if( pvList ) {
+        ulist_flush( pvList );
+        free( pvList );
+    }
+}
+
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/
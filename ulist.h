@@ -0,0 +1,212 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                      Copyright (C) 2014 Chen Yan                           *
+ *                     Licensed under the MIT license                         *
+ *                                                                            *
+ *                         The MIT License (MIT)                              *
+ *                                                                            *
+ * Permission is hereby granted, free of charge, to any person obtaining a    *
+ * copy of this software and associated documentation files (the "Software"), *
+ * to deal in the Software without restriction, including without limitation  *
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,   *
+ * and/or sell copies of the Software, and to permit persons to whom the      *
+ * Software is furnished to do so, subject to the following conditions:       *
+ *                                                                            *
+ * The above copyright notice and this permission notice shall be included in *
+ * all copies or substantial portions of the Software.                        *
+ *                                                                            *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR *
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   *
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    *
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    *
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        *
+ * DEALINGS IN THE SOFTWARE.                                                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**************************************************************************//**
+ * @file        ulist.h
+ * @date        2026-10-17
+ * @author      Chen Yan  <leochenlinux@gmail.com>
+ * @brief       Unrolled doubly linked list
+ * @par         Copyright
+ * Copyright (C) Chen Yan 2014 -2016. All rights reserved.
+ *****************************************************************************/
+
+#ifndef _ULIST_H_
+#define _ULIST_H_
+
+/* Includes ---------------------------------------------------------------- */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type Definitions -------------------------------------------------------- */
+
+/* Position of an element. It stays valid until the list is modified, except
+ * by the call it was passed to, which keeps it up to date. */
+typedef struct _ULIST_POS_T {
+    void *m_pvBlock;
+    uint32_t m_uiIndex;
+} ulist_pos_t;
+
+/* Visitor called on every element, returns non-zero to stop the walk */
+typedef int (*ulist_visit_t)( void *pvElem, void *pvCtx );
+
+/* External Interfaces ----------------------------------------------------- */
+
+/**************************************************************************//**
+ * @fn          ulist_create
+ * @param [in]  uiElemSize   - Size of every element
+ * @param [in]  uiBlockElems - Number of elements per block, 0 for default
+ * @return      Handle of the created list or NULL if failed
+ * @brief       Create a new empty unrolled list. Elements are stored by value
+ *              in blocks holding a small array each, so a walk touches
+ *              memory mostly contiguously.
+ *****************************************************************************/
+void *ulist_create( uint32_t uiElemSize, uint32_t uiBlockElems );
+
+/**************************************************************************//**
+ * @fn          ulist_add_rear
+ * @param [in]  pvList - List handle
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the added element or NULL if failed
+ * @brief       Add an element at the end of a list
+ *****************************************************************************/
+void *ulist_add_rear( void *pvList, const void *pvData );
+
+/**************************************************************************//**
+ * @fn          ulist_add_front
+ * @param [in]  pvList - List handle
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the added element or NULL if failed
+ * @brief       Add an element at the beginning of a list
+ *****************************************************************************/
+void *ulist_add_front( void *pvList, const void *pvData );
+
+/**************************************************************************//**
+ * @fn          ulist_insert_before
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the inserted one
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the inserted element or NULL if failed
+ * @brief       Insert an element before another element. A full block is
+ *              split in two halves first.
+ *****************************************************************************/
+void *ulist_insert_before( void *pvList, ulist_pos_t *psPos, const void *pvData );
+
+/**************************************************************************//**
+ * @fn          ulist_insert_after
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the inserted one
+ * @param [in]  pvData - Element to copy in, NULL to leave it uninitialized
+ * @return      Pointer to the inserted element or NULL if failed
+ * @brief       Insert an element after another element. A full block is
+ *              split in two halves first.
+ *****************************************************************************/
+void *ulist_insert_after( void *pvList, ulist_pos_t *psPos, const void *pvData );
+
+/**************************************************************************//**
+ * @fn          ulist_erase
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the one following it
+ * @return      None
+ * @brief       Delete an element from list. A block less than half full is
+ *              merged with a neighbour when they fit in one block.
+ *****************************************************************************/
+void ulist_erase( void *pvList, ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_first
+ * @param [in]  pvList - List handle
+ * @param [out] psPos  - Position of the element
+ * @return      true if founded, false if the list is empty
+ * @brief       Get the element at the beginning of the specified list.
+ *****************************************************************************/
+bool ulist_first( void *pvList, ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_last
+ * @param [in]  pvList - List handle
+ * @param [out] psPos  - Position of the element
+ * @return      true if founded, false if the list is empty
+ * @brief       Get the element at the end of the specified list.
+ *****************************************************************************/
+bool ulist_last( void *pvList, ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_next
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the next one
+ * @return      true if moved, false if reach the end of list
+ * @brief       Move a position to the next element
+ *****************************************************************************/
+bool ulist_next( void *pvList, ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_prev
+ * @param [in]  pvList - List handle
+ * @param [in,out] psPos - Position of an element, set to the previous one
+ * @return      true if moved, false if reach the beginning of list
+ * @brief       Move a position to the previous element
+ *****************************************************************************/
+bool ulist_prev( void *pvList, ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_data
+ * @param [in]  pvList - List handle
+ * @param [in]  psPos  - Position of an element
+ * @return      Pointer to the element or NULL if not a valid position
+ * @brief       Get the element at a position
+ *****************************************************************************/
+void *ulist_data( void *pvList, const ulist_pos_t *psPos );
+
+/**************************************************************************//**
+ * @fn          ulist_for_each
+ * @param [in]  pvList - List handle
+ * @param [in]  pfnVisit - Visitor called on every element in order
+ * @param [in]  pvCtx  - User context passed to the visitor
+ * @return      None
+ * @brief       Walk all elements, scanning the array of each block
+ *****************************************************************************/
+void ulist_for_each( void *pvList, ulist_visit_t pfnVisit, void *pvCtx );
+
+/**************************************************************************//**
+ * @fn          ulist_length
+ * @param [in]  pvList - List handle
+ * @return      The number of elements in the list.
+ * @brief       Get the number of elements in a list.
+ *****************************************************************************/
+uint32_t ulist_length( void *pvList );
+
+/**************************************************************************//**
+ * @fn          ulist_flush
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Flush a list. All elements and blocks will be freed
+ *****************************************************************************/
+void ulist_flush( void *pvList );
+
+/**************************************************************************//**
+ * @fn          ulist_destroy
+ * @param [in]  pvList - List handle
+ * @return      None
+ * @brief       Free the list including all elements in it.
+ *****************************************************************************/
+void ulist_destroy( void *pvList );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ULIST_H_ */
+/******************************************************************************
+ *                              End of File
+ *****************************************************************************/